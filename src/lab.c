@@ -1,6 +1,12 @@
 #include "lab.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
 /*
  * =====
  * TYPES
@@ -32,18 +38,642 @@ typedef struct Node {
 typedef struct SentinelLinkedList {
   Node *head, *tail;
   size_t size;
+  // Last node resolved by an index lookup (NULL when unset) and its index, so
+  // lookups of nearby indices walk from here instead of the head or tail
+  Node *finger;
+  size_t finger_index;
+  // The sentinel itself, stored inline (head always points here)
+  Node sentinel;
 } SentinelLinkedList;
 
+/**
+ * @struct ArrayList
+ * @brief ArrayList struct that stores element pointers in one contiguous,
+ * growable buffer
+ */
+typedef struct ArrayList {
+  void **items;
+  size_t size, capacity;
+  const ListAllocator *allocator; // the owning list's allocator
+} ArrayList;
+
+/**
+ * @struct GapBufferList
+ * @brief GapBufferList struct that stores element pointers around a movable
+ * gap of unused slots [gap_start, gap_end)
+ */
+typedef struct GapBufferList {
+  void **items;
+  size_t capacity, gap_start, gap_end;
+  const ListAllocator *allocator; // the owning list's allocator
+} GapBufferList;
+
+// Unrolled blocks span two 64 byte cache lines: link/count header + elements
+#define UNROLLED_CACHE_LINE 64
+#define UNROLLED_NODE_BYTES (2 * UNROLLED_CACHE_LINE)
+#define UNROLLED_NODE_CAPACITY                                                 \
+  ((UNROLLED_NODE_BYTES - 2 * sizeof(void *) - sizeof(size_t)) / sizeof(void *))
+
+/**
+ * @struct UnrolledNode
+ * @brief a block of an unrolled list holding up to UNROLLED_NODE_CAPACITY
+ * element pointers, packed at the front of `items`
+ */
+typedef struct UnrolledNode {
+  struct UnrolledNode *next, *prev;
+  size_t count;
+  void *items[UNROLLED_NODE_CAPACITY];
+} UnrolledNode;
+
+_Static_assert(sizeof(UnrolledNode) == UNROLLED_NODE_BYTES,
+               "UnrolledNode must fill its cache lines exactly");
+
+/**
+ * @struct UnrolledList
+ * @brief UnrolledList struct that links blocks of element pointers
+ */
+typedef struct UnrolledList {
+  UnrolledNode *head, *tail;
+  size_t size;
+  struct NodePool *pool;          // the list's block pool, if any
+  const ListAllocator *allocator; // the owning list's allocator
+} UnrolledList;
+
+// 1 in 4 nodes is promoted per level, so 16 levels cover ~4 billion elements
+#define SKIP_LIST_MAX_LEVEL 16
+
+/**
+ * @struct SkipLink
+ * @brief a forward link of a skip list node with its span width (the number of
+ * level 0 steps it jumps over)
+ */
+typedef struct SkipLink {
+  struct SkipNode *next;
+  size_t width;
+} SkipLink;
+
+/**
+ * @struct SkipNode
+ * @brief a skip list node with `level` forward links stored inline
+ */
+typedef struct SkipNode {
+  void *data;
+  struct SkipNode *prev; // level 0 back link (the head for the first node)
+  size_t level;
+  SkipLink links[];
+} SkipNode;
+
+/**
+ * @struct SkipList
+ * @brief SkipList struct for an indexable skip list. The head node owns
+ * SKIP_LIST_MAX_LEVEL links; a NULL link spans to one past the last element.
+ */
+typedef struct SkipList {
+  SkipNode *head;
+  size_t size, level;
+  uint64_t seed;
+  const ListAllocator *allocator; // the owning list's allocator
+} SkipList;
+
+/**
+ * @struct TreeNode
+ * @brief an AVL tree node caching the size and height of its subtree
+ */
+typedef struct TreeNode {
+  struct TreeNode *left, *right, *parent;
+  void *data;
+  size_t size, height;
+} TreeNode;
+
+/**
+ * @struct TreeList
+ * @brief TreeList struct ordering elements by in-order position in a
+ * height-balanced (AVL) tree
+ */
+typedef struct TreeList {
+  TreeNode *root;
+  struct NodePool *pool;          // the list's node pool, if any
+  const ListAllocator *allocator; // the owning list's allocator
+} TreeList;
+
+/**
+ * @struct ConcurrentList
+ * @brief ConcurrentList struct that guards a sentinel list with a
+ * reader-writer lock: readers share it, writers hold it exclusively. Readers
+ * never move the finger, so they only ever read the list.
+ */
+typedef struct ConcurrentList {
+  pthread_rwlock_t lock;
+  SentinelLinkedList list;
+} ConcurrentList;
+
+// Keeps the two ends of the lock-free types on separate cache lines (padding
+// works whatever the allocation's alignment)
+#define LOCKFREE_CACHE_LINE 64
+
+// Padding that rounds `bytes` of fields up to whole cache lines
+#define LOCKFREE_PAD(bytes)                                                    \
+  (LOCKFREE_CACHE_LINE - (bytes) % LOCKFREE_CACHE_LINE)
+
+/**
+ * @struct MpscQueue
+ * @brief MpscQueue struct for an intrusive lock-free multi-producer
+ * single-consumer queue (Vyukov's design) linked through Node next pointers.
+ * Producers swap themselves in as the tail and then link the old tail to
+ * them; the consumer pops from the head. The stub node keeps the queue
+ * non-empty so neither side needs to special-case an empty queue.
+ */
+typedef struct MpscQueue {
+  // Producer side
+  Node *tail;    // most recently appended node
+  size_t pushed; // nodes ever appended (counted before linking)
+  char producer_pad[LOCKFREE_CACHE_LINE - sizeof(Node *) - sizeof(size_t)];
+  // Consumer side
+  Node *head;    // next node to pop (may be the stub)
+  size_t popped; // nodes ever popped (written by the consumer only)
+  Node stub;
+} MpscQueue;
+
+#define LOCKFREE_DEQUE_INITIAL_CAPACITY 32
+
+/**
+ * @struct DequeArray
+ * @brief circular buffer behind a lock-free deque. A full buffer is replaced
+ * rather than resized in place, and kept (linked through `retired`) until
+ * the deque is destroyed, since a thief may still be reading it.
+ */
+typedef struct DequeArray {
+  size_t capacity;            // always a power of two
+  struct DequeArray *retired; // the buffer this one replaced
+  void *items[];
+} DequeArray;
+
+/**
+ * @struct LockFreeDeque
+ * @brief LockFreeDeque struct for a Chase-Lev work-stealing deque. The owner
+ * pushes and pops at `bottom`; thieves take from `top` with a CAS, which the
+ * owner also uses when it races them for the last element.
+ */
+typedef struct LockFreeDeque {
+  // Thief side
+  int64_t top; // index of the oldest element
+  char thief_pad[LOCKFREE_CACHE_LINE - sizeof(int64_t)];
+  // Owner side
+  int64_t bottom; // index one past the newest element
+  DequeArray *array;
+  const ListAllocator *allocator; // the owning list's allocator
+} LockFreeDeque;
+
+// Read-side sections are counted in this many slots, picked by hashing the
+// thread, so readers on different cores rarely share a cache line
+#define RCU_READER_SLOTS 64
+
+/**
+ * @struct RcuReaderSlot
+ * @brief open read-side sections of the threads hashed to one slot, counted
+ * separately for each of the two grace-period phases.
+ */
+typedef struct RcuReaderSlot {
+  size_t active[2];
+  char pad[LOCKFREE_CACHE_LINE - 2 * sizeof(size_t)];
+} RcuReaderSlot;
+
+/**
+ * @struct RcuList
+ * @brief RcuList struct for a read-copy-update sentinel list. Readers only
+ * follow next pointers (with acquire loads) and never write the list; the
+ * one write of a read-side section is an atomic add on its reader slot.
+ * Writers serialize on a mutex and publish links with release stores. An
+ * unlinked node keeps its next pointer, and it is only handed back once
+ * every read-side section that could still see it has ended (a grace
+ * period).
+ */
+typedef struct RcuList {
+  RcuReaderSlot readers[RCU_READER_SLOTS];
+  // Writer side (the padded slots keep it off the readers' lines)
+  size_t phase; // sections started now count in active[phase & 1]
+  pthread_mutex_t lock;
+  SentinelLinkedList list; // the finger is only used by writers
+} RcuList;
+
+// Upper bound on shards (list_create uses one per online CPU)
+#define SHARDED_MAX_SHARDS 64
+
+/**
+ * @struct ListShard
+ * @brief one shard of a sharded list: the nodes appended by the threads
+ * hashed to it since the list was last gathered, behind their own lock and
+ * cache line.
+ */
+typedef struct ListShard {
+  pthread_mutex_t lock;
+  SentinelLinkedList list;
+  size_t size;       // list.size, readable without the lock
+  uint64_t *tickets; // ordered lists: append ticket of each node, in order
+  size_t ticket_capacity;
+  char pad[LOCKFREE_PAD(sizeof(pthread_mutex_t) + sizeof(SentinelLinkedList) +
+                        3 * sizeof(size_t))];
+} ListShard;
+
+/**
+ * @struct ShardedList
+ * @brief ShardedList struct that spreads appends over per-thread shards so
+ * appending threads rarely share a lock or a tail. Everything else works on
+ * the gathered list: the list lock is taken and every shard's nodes are
+ * moved onto its end first, spliced shard by shard, or merged by append
+ * ticket when the list is ordered.
+ */
+typedef struct ShardedList {
+  pthread_mutex_t lock;       // guards `gathered`
+  SentinelLinkedList gathered; // the global view, minus pending appends
+  size_t gathered_size;       // gathered.size, readable without the lock
+  uint64_t next_ticket;       // ordered lists: next append ticket
+  size_t shard_count;
+  bool ordered;
+  // Keeps the shards off the lines of the gathered list
+  char pad[LOCKFREE_PAD(sizeof(pthread_mutex_t) + sizeof(SentinelLinkedList) +
+                        3 * sizeof(size_t) + sizeof(bool))];
+  ListShard shards[];
+} ShardedList;
+
+_Static_assert(sizeof(ListShard) % LOCKFREE_CACHE_LINE == 0,
+               "each shard must fill whole cache lines");
+_Static_assert(offsetof(ShardedList, shards) % LOCKFREE_CACHE_LINE == 0,
+               "the shards must start on a cache line boundary");
+
+// Capacity of a bounded queue made with list_create (see list_create_bounded)
+#define BOUNDED_DEFAULT_CAPACITY 1024
+
+// Timeout that waits for as long as it takes
+#define BOUNDED_WAIT_FOREVER SIZE_MAX
+
+/**
+ * @struct BoundedQueue
+ * @brief BoundedQueue struct for a sentinel list with a capacity, behind a
+ * mutex. Producers that find it full wait on `not_full` and consumers that
+ * find it empty wait on `not_empty`. Wakeups are batched: a batch of
+ * elements wakes consumers with one broadcast, and each freed slot wakes one
+ * producer, while all of them are woken once `wake_batch` slots are free (or
+ * whenever a producer waits to insert a batch).
+ */
+typedef struct BoundedQueue {
+  pthread_mutex_t lock;
+  pthread_cond_t not_empty; // consumers wait here
+  pthread_cond_t not_full;  // producers wait here
+  size_t capacity;
+  size_t wake_batch; // free slots that wake all waiting producers
+  size_t waiting_consumers;
+  size_t waiting_producers;
+  size_t waiting_batch_producers; // those waiting to insert several elements
+  bool closed; // pushes fail and pops stop waiting
+  SentinelLinkedList list;
+} BoundedQueue;
+
+// Most worker threads the built-in pool starts (the caller runs tasks too)
+#define LIST_POOL_MAX_THREADS 63
+
+/**
+ * @struct ListPoolJob
+ * @brief one caller's batch of tasks for the thread pool. Task numbers are
+ * claimed from a shared counter, so threads that finish early take more.
+ */
+typedef struct ListPoolJob {
+  void (*run)(void *arg, size_t task);
+  void *arg;
+  size_t count;  // tasks 0 .. count - 1
+  size_t next;   // next unclaimed task (atomic)
+  size_t active; // workers still running tasks of this job (pool lock)
+} ListPoolJob;
+
+/**
+ * @struct ListPool
+ * @brief the process-wide pool behind the parallel list functions. Workers
+ * are started on first need, then sleep on `wake` between jobs; one job runs
+ * at a time.
+ */
+typedef struct ListPool {
+  pthread_mutex_t lock;
+  pthread_cond_t wake;      // workers wait for a job here
+  pthread_cond_t done;      // the caller waits for its workers here
+  pthread_mutex_t job_lock; // held by the caller for the length of a job
+  ListPoolJob *job;         // current job, or NULL
+  uint64_t generation;      // bumped for every job
+  size_t threads;           // workers started so far
+} ListPool;
+
 typedef struct List {
   ListType type;
+  // Whether the header was allocated by list_create (false after list_init)
+  bool owned;
 
   // AI Use: Assisted by AI
   // I needed a form of inheritence to keep this type generic
+  // NOTE: implementations live inline so a list is a single allocation
   union {
-    struct SentinelLinkedList *sentinel_list;
+    SentinelLinkedList sentinel_list;
+    ArrayList array_list;
+    GapBufferList gap_list;
+    UnrolledList unrolled_list;
+    SkipList skip_list;
+    TreeList tree_list;
+    // Allocated separately: the lock would otherwise double every header
+    struct ConcurrentList *concurrent_list;
+    // Allocated separately: the two ends sit on separate cache lines
+    struct MpscQueue *mpsc_queue;
+    // Allocated separately: the two ends sit on separate cache lines
+    struct LockFreeDeque *lockfree_deque;
+    // Allocated separately: reader slots sit on their own cache lines
+    struct RcuList *rcu_list;
+    // Allocated separately: one cache-line padded shard per core
+    struct ShardedList *sharded_list;
+    // Allocated separately: the lock would otherwise double every header
+    struct BoundedQueue *bounded_queue;
   } lists;
+
+  // Allocation hooks every internal allocation goes through
+  ListAllocator allocator;
+  // Optional node pool (NULL unless created with list_create_with_allocator)
+  struct NodePool *pool;
 } List;
 
+_Static_assert(sizeof(List) <= LIST_STORAGE_SIZE,
+               "LIST_STORAGE_SIZE must hold a List");
+_Static_assert(_Alignof(List) <= _Alignof(ListStorage),
+               "ListStorage must be aligned for a List");
+
+// The sentinel list is the largest implementation (tests mirror it alone)
+_Static_assert(sizeof(((List *)0)->lists) == sizeof(SentinelLinkedList),
+               "sentinel list must be the largest list implementation");
+
+/*
+ * ======
+ * MEMORY
+ * ======
+ */
+
+/**
+ * @brief Allocate through the allocator hooks (malloc without hooks).
+ * @param allocator Pointer to the allocator.
+ * @param size Number of bytes.
+ * @return Pointer to the memory, or NULL on failure.
+ */
+void *list_mem_alloc(const ListAllocator *allocator, size_t size) {
+  return (allocator->alloc) ? allocator->alloc(allocator->ctx, size)
+                            : malloc(size);
+}
+
+/**
+ * @brief Free through the allocator hooks (free without hooks).
+ * @param allocator Pointer to the allocator.
+ * @param ptr Pointer to memory from list_mem_alloc (NULL is ignored).
+ */
+void list_mem_free(const ListAllocator *allocator, void *ptr) {
+  if (!ptr)
+    return;
+  if (allocator->free)
+    allocator->free(allocator->ctx, ptr);
+  else
+    free(ptr);
+}
+
+/**
+ * @brief Check whether memory from one allocator may be freed through
+ * another, i.e. both use the same hooks with the same context.
+ * @param a Pointer to the first allocator.
+ * @param b Pointer to the second allocator.
+ * @return true if the hooks and context match.
+ */
+bool list_mem_same(const ListAllocator *a, const ListAllocator *b) {
+  return a->alloc == b->alloc && a->free == b->free && a->ctx == b->ctx;
+}
+
+/**
+ * @brief Allocate memory aligned to `align` where possible. Hooks only
+ * guarantee malloc alignment, so `align` is a performance hint: the types
+ * allocated here must not need more than malloc alignment themselves.
+ * @param allocator Pointer to the allocator.
+ * @param align Alignment in bytes (a power of two).
+ * @param size Number of bytes (rounded up to a multiple of `align`).
+ * @return Pointer to the memory, or NULL on failure.
+ */
+void *list_mem_aligned_alloc(const ListAllocator *allocator, size_t align,
+                             size_t size) {
+  size = (size + align - 1) & ~(align - 1);
+  return (allocator->alloc) ? allocator->alloc(allocator->ctx, size)
+                            : aligned_alloc(align, size);
+}
+
+/**
+ * @brief Resize memory from list_mem_alloc, keeping its contents.
+ * @param allocator Pointer to the allocator.
+ * @param ptr Pointer to the memory (NULL allocates).
+ * @param oldSize Current size in bytes.
+ * @param newSize New size in bytes.
+ * @return Pointer to the resized memory, or NULL on failure (`ptr` is kept).
+ */
+void *list_mem_resize(const ListAllocator *allocator, void *ptr,
+                      size_t oldSize, size_t newSize) {
+  if (!allocator->alloc)
+    return realloc(ptr, newSize);
+
+  // Hooks have no resize: move to a new block
+  void *newPtr = allocator->alloc(allocator->ctx, newSize);
+  if (!newPtr)
+    return NULL;
+  if (ptr) {
+    memcpy(newPtr, ptr, (oldSize < newSize) ? oldSize : newSize);
+    list_mem_free(allocator, ptr);
+  }
+  return newPtr;
+}
+
+/**
+ * @brief Allocate a list header of a given type, or set one up in place.
+ * @param storage Caller-provided storage for the header, or NULL to allocate.
+ * @param type The type of list.
+ * @param allocator Allocation options to copy into the list, or NULL.
+ * @return Pointer to the header, or NULL on failure.
+ */
+List *list_alloc_header(List *storage, ListType type,
+                        const ListAllocator *allocator) {
+  ListAllocator defaults = {0};
+  if (!allocator)
+    allocator = &defaults;
+
+  List *list = (storage) ? storage : list_mem_alloc(allocator, sizeof(List));
+  if (!list)
+    return NULL;
+  list->type = type;
+  list->owned = (storage == NULL);
+  list->allocator = *allocator;
+  list->pool = NULL;
+  return list;
+}
+
+/**
+ * @brief Free a list header through its own allocator (caller-provided
+ * storage is left alone).
+ * @param list Pointer to the list.
+ */
+void list_free_header(List *list) {
+  if (!list->owned)
+    return;
+  ListAllocator allocator = list->allocator;
+  list_mem_free(&allocator, list);
+}
+
+/*
+ * =========
+ * NODE POOL
+ * =========
+ */
+
+// Slabs (and so every block of a block size that is a multiple of this) start
+// on a cache line
+#define NODE_POOL_ALIGN 64
+
+/**
+ * @struct PoolSlab
+ * @brief header of one slab of pooled blocks; the blocks follow it, starting
+ * at the next NODE_POOL_ALIGN boundary
+ */
+typedef struct PoolSlab {
+  struct PoolSlab *next;
+} PoolSlab;
+
+/**
+ * @struct NodePool
+ * @brief fixed-size block allocator that carves blocks out of slabs and
+ * recycles freed blocks through an intrusive free list. Lists created from
+ * each other (e.g., by list_split_at) share one pool through `refs`.
+ */
+typedef struct NodePool {
+  ListAllocator allocator; // copied: the pool may outlive the creating list
+  size_t block_size, slab_blocks, refs;
+  void *free_list;  // freed blocks, linked through their first word
+  PoolSlab *slabs;  // every slab, oldest first
+  PoolSlab *current; // slab blocks are carved from (NULL: none yet)
+  char *bump;       // next never used block of `current`
+  size_t bump_left; // blocks left after `bump`
+} NodePool;
+
+/**
+ * @brief Create a node pool.
+ * @param block_size Size of each block (rounded up for alignment).
+ * @param slab_blocks Number of blocks per slab.
+ * @param allocator Allocator the pool and its slabs come from.
+ * @return Pointer to the new pool, or NULL on failure.
+ */
+NodePool *node_pool_create(size_t block_size, size_t slab_blocks,
+                           const ListAllocator *allocator) {
+  NodePool *pool = list_mem_alloc(allocator, sizeof(NodePool));
+  if (!pool)
+    return NULL;
+  pool->allocator = *allocator;
+
+  // Blocks must hold the free list link and keep any node type aligned
+  size_t align = _Alignof(max_align_t);
+  if (block_size < sizeof(void *))
+    block_size = sizeof(void *);
+  pool->block_size = (block_size + align - 1) / align * align;
+  pool->slab_blocks = slab_blocks;
+  pool->refs = 1;
+  pool->free_list = NULL;
+  pool->slabs = pool->current = NULL;
+  pool->bump = NULL;
+  pool->bump_left = 0;
+
+  return pool;
+}
+
+/**
+ * @brief Take a block from the pool, reusing freed blocks first.
+ * @param pool Pointer to the pool.
+ * @return Pointer to the block, or NULL on failure.
+ */
+void *node_pool_alloc(NodePool *pool) {
+  if (pool->free_list) {
+    void *block = pool->free_list;
+    pool->free_list = *(void **)block;
+    return block;
+  }
+
+  if (pool->bump_left == 0) {
+    // Move on to the next slab, reusing slabs emptied by node_pool_reset
+    PoolSlab *slab = (pool->current) ? pool->current->next : pool->slabs;
+    if (!slab) {
+      size_t bytes = NODE_POOL_ALIGN + pool->slab_blocks * pool->block_size;
+      bytes = (bytes + NODE_POOL_ALIGN - 1) / NODE_POOL_ALIGN * NODE_POOL_ALIGN;
+      slab = list_mem_aligned_alloc(&pool->allocator, NODE_POOL_ALIGN, bytes);
+      if (!slab)
+        return NULL;
+      slab->next = NULL;
+      if (pool->current)
+        pool->current->next = slab;
+      else
+        pool->slabs = slab;
+    }
+    pool->current = slab;
+    pool->bump = (char *)slab + NODE_POOL_ALIGN;
+    pool->bump_left = pool->slab_blocks;
+  }
+
+  void *block = pool->bump;
+  pool->bump += pool->block_size;
+  pool->bump_left -= 1;
+  return block;
+}
+
+/**
+ * @brief Return a block to the pool's free list.
+ * @param pool Pointer to the pool.
+ * @param block Pointer to a block taken from this pool.
+ */
+void node_pool_free(NodePool *pool, void *block) {
+  *(void **)block = pool->free_list;
+  pool->free_list = block;
+}
+
+/**
+ * @brief Return every block to the pool at once in O(1), keeping the slabs
+ * for reuse. Blocks handed out before the reset must no longer be used.
+ * @param pool Pointer to the pool.
+ */
+void node_pool_reset(NodePool *pool) {
+  pool->free_list = NULL;
+  pool->current = NULL;
+  pool->bump = NULL;
+  pool->bump_left = 0;
+}
+
+/**
+ * @brief Check whether a list is the only user of its node pool, so clearing
+ * it may reset the pool wholesale.
+ * @param list Pointer to the list.
+ * @return true if the list has a pool no other list shares.
+ */
+bool list_owns_pool(const List *list) {
+  return list->pool && list->pool->refs == 1;
+}
+
+/**
+ * @brief Drop one reference to the pool, releasing every slab with the last.
+ * @param pool Pointer to the pool (NULL is ignored).
+ */
+void node_pool_release(NodePool *pool) {
+  if (!pool || --pool->refs > 0)
+    return;
+
+  ListAllocator allocator = pool->allocator;
+  PoolSlab *slab = pool->slabs;
+  while (slab) {
+    PoolSlab *nextSlab = slab->next;
+    list_mem_free(&allocator, slab);
+    slab = nextSlab;
+  }
+  list_mem_free(&allocator, pool);
+}
+
 /*
  * ================
  * HELPER FUNCTIONS
@@ -63,101 +693,181 @@ bool index_in_bounds(size_t size, size_t index) {
   return (index < size && index >= 0);
 }
 
-size_t sentinel_list_size(SentinelLinkedList *sentinel_list) {
-  return sentinel_list->size;
+// Only its address is used: every thread gets its own
+static _Thread_local unsigned char list_thread_marker;
+
+/**
+ * @brief Hash the calling thread, to spread threads over per-thread slots
+ * without registering them.
+ * @return Fibonacci hash of a thread-local address (use the high bits).
+ */
+uint64_t list_thread_hash(void) {
+  return (uint64_t)(uintptr_t)&list_thread_marker * 0x9E3779B97F4A7C15ull;
 }
 
-void *sentinel_list_get(SentinelLinkedList *sentinel_list, size_t index) {
+size_t sentinel_list_size(const SentinelLinkedList *sentinel_list) {
+  return sentinel_list->size;
+}
 
-  // Start at tail or head based on which is closest
-  // (unnecessary for small sets of data)
-  bool nodeIsCloseToTail = index > (sentinel_list->size / 2); // index > middle
-  int currIdx = (nodeIsCloseToTail) ? sentinel_list->size - 1
-                                    : -1; // (-1) accounts for sentinel
-  Node *currNode =
-      (nodeIsCloseToTail) ? sentinel_list->tail : sentinel_list->head;
-  Node *nextNode = currNode->next;
-
-  // Find node at given index
-  // (List is empty || index within bounds)
-  while (currIdx != index) {
-    // ? shift backward : shift forward
-    currNode = nextNode;
-    currIdx += (nodeIsCloseToTail) ? -1 : 1;
-    nextNode = currNode->next;
+/**
+ * @brief Find the node at a specific index, walking from whichever of the
+ * head, the tail or the cached finger is closest, without moving the finger
+ * (safe for concurrent readers).
+ * @param sentinel_list Pointer to the sentinel list.
+ * @param index Index of the node to find; index == size resolves to the
+ * sentinel (the position an append links before).
+ * @return The node, or NULL if index is out of bounds.
+ */
+Node *sentinel_list_walk(const SentinelLinkedList *sentinel_list,
+                         size_t index) {
+  if (index > sentinel_list_size(sentinel_list))
+    return NULL;
 
-    // Index bounds check
-    if (!index_in_bounds(sentinel_list_size(sentinel_list), currIdx))
-      break;
+  // The sentinel sits both before index 0 and after index size - 1
+  Node *currNode = sentinel_list->head;
+  size_t steps = index + 1;
+  bool forward = true;
+  if (sentinel_list_size(sentinel_list) - index < steps) {
+    steps = sentinel_list_size(sentinel_list) - index;
+    forward = false;
   }
 
-  // Check index was found
-  if (currIdx != index) { // GCOVR_EXCL_START
-    return NULL;
-  } // GCOVR_EXCL_STOP
+  // Sequential lookups (i, i + 1, ...) are a single step from the finger
+  if (sentinel_list->finger) {
+    size_t fingerIdx = sentinel_list->finger_index;
+    size_t distance =
+        (fingerIdx > index) ? fingerIdx - index : index - fingerIdx;
+    if (distance < steps) {
+      currNode = sentinel_list->finger;
+      steps = distance;
+      forward = index > fingerIdx;
+    }
+  }
 
+  while (steps-- > 0)
+    currNode = (forward) ? currNode->next : currNode->prev;
   return currNode;
 }
 
 /**
- * @brief Create a new list of the specified type.
- * @return Pointer to the newly created list, or NULL on failure.
+ * @brief Find the node at a specific index and cache it as the finger.
+ * @param sentinel_list Pointer to the sentinel list.
+ * @param index Index of the node to find; index == size resolves to the
+ * sentinel (the position an append links before).
+ * @return The node, or NULL if index is out of bounds.
  */
-List *sentinel_list_create(void) {
-  List *list = malloc(sizeof(List));
-  list->type = LIST_LINKED_SENTINEL;
+Node *sentinel_list_find(SentinelLinkedList *sentinel_list, size_t index) {
+  Node *currNode = sentinel_list_walk(sentinel_list, index);
+  if (currNode && currNode != sentinel_list->head) {
+    sentinel_list->finger = currNode;
+    sentinel_list->finger_index = index;
+  }
+  return currNode;
+}
 
-  // Creates SentinelList Pointer
-  // NOTE: allocates memory separately to optimize sizeof List
-  // (avoid unnecessary allocation to unused implementations in the future)
-  list->lists.sentinel_list = malloc(sizeof(SentinelLinkedList));
+void *sentinel_list_get(SentinelLinkedList *sentinel_list, size_t index) {
+  if (!index_in_bounds(sentinel_list_size(sentinel_list), index))
+    return NULL;
+  return sentinel_list_find(sentinel_list, index);
+}
 
+/**
+ * @brief Set up an empty sentinel list around its inline sentinel node.
+ * @param sentinel_list Pointer to the sentinel list.
+ */
+void sentinel_list_init(SentinelLinkedList *sentinel_list) {
   // Sentinel node will always be the head -- we want tail on the first appended
   // element later
-  Node *sentinelNode = malloc(sizeof(Node));
+  Node *sentinelNode = &sentinel_list->sentinel;
   sentinelNode->type = SENTINEL;
   // Sets all meta data pointers to sentinel node initially
-  list->lists.sentinel_list->head = list->lists.sentinel_list->tail =
-      sentinelNode->next = sentinelNode->prev = sentinelNode;
+  sentinel_list->head = sentinel_list->tail = sentinelNode->next =
+      sentinelNode->prev = sentinelNode;
 
   // Sentinel node should not count toward size
-  list->lists.sentinel_list->size = 0;
+  sentinel_list->size = 0;
+  sentinel_list->finger = NULL;
+  sentinel_list->finger_index = 0;
+}
+
+/**
+ * @brief Create a new list of the specified type.
+ * @param storage Caller-provided storage for the list, or NULL to allocate.
+ * @param allocator Allocation options, or NULL for the defaults.
+ * @return Pointer to the newly created list, or NULL on failure.
+ */
+List *sentinel_list_create(List *storage, const ListAllocator *allocator) {
+  List *list = list_alloc_header(storage, LIST_LINKED_SENTINEL, allocator);
+  if (!list)
+    return NULL;
 
+  // The sentinel lives inline in the header: one allocation per list
+  sentinel_list_init(&list->lists.sentinel_list);
   return list;
 }
 
 /**
- * @brief Destroy the list and free all associated memory.
- * @param list Pointer to the list to destroy.
+ * @brief Reset a sentinel list to empty without touching its former nodes.
+ * @param sentinel_list Pointer to the sentinel list.
+ */
+void sentinel_list_reset(SentinelLinkedList *sentinel_list) {
+  Node *sentinelNode = sentinel_list->head;
+  sentinel_list->tail = sentinelNode->next = sentinelNode->prev = sentinelNode;
+  sentinel_list->size = 0;
+  sentinel_list->finger = NULL;
+  sentinel_list->finger_index = 0;
+}
+
+/**
+ * @brief Hand every element to free_func and reset the list to empty.
+ * @param sentinel_list Pointer to the sentinel list.
  * @param free_func Function to free individual elements. If NULL, elements are
  * not freed.
  */
-void sentinel_list_destroy(List *list, FreeFunc free_func) {
-  SentinelLinkedList *sentinel_list = list->lists.sentinel_list;
+void sentinel_list_release(SentinelLinkedList *sentinel_list,
+                           FreeFunc free_func) {
+  Node *sentinelNode = sentinel_list->head;
 
   // User must pass (non-null) FreeFunc to destroy elements
   // NOTE: If skipped, manually cleanup nodes in the list later
+  // NOTE: the sentinel is never handed to free_func
   if (free_func) {
-    Node *sentinelNode = sentinel_list->head;
-    Node *currNode = sentinelNode;
-    Node *nextNode = currNode->next;
-
-    while (currNode != NULL) { // GCOVR_EXCL_START
-      free_func(currNode);     // GCOVR_EXCL_STOP
-      // Reduce size
-      sentinel_list->size = list_size(list) - 1;
-      // Update currNode until loops back to sentinel node
-      currNode = (nextNode == sentinelNode) ? NULL : nextNode;
-      // Update next node
-      nextNode = (currNode) ? currNode->next : NULL;
+    Node *currNode = sentinelNode->next;
+    while (currNode != sentinelNode) {
+      Node *nextNode = currNode->next;
+      free_func(currNode);
+      currNode = nextNode;
     }
   }
 
-  // Finally cleanup lists
-  free(sentinel_list); // GCOVR_EXCL_START
-  sentinel_list = NULL;
-  free(list);
-  list = NULL; // GCOVR_EXCL_STOP
+  sentinel_list_reset(sentinel_list);
+}
+
+/**
+ * @brief Remove every element, keeping the list (and its pool slabs) for
+ * reuse.
+ * @param list Pointer to the list to clear.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void sentinel_list_clear(List *list, FreeFunc free_func) {
+  sentinel_list_release(&list->lists.sentinel_list, free_func);
+  if (list_owns_pool(list))
+    node_pool_reset(list->pool);
+}
+
+/**
+ * @brief Destroy the list and free all associated memory.
+ * @param list Pointer to the list to destroy.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void sentinel_list_destroy(List *list, FreeFunc free_func) {
+  sentinel_list_clear(list, free_func);
+
+  // Finally cleanup the list (the inline sentinel goes with the header)
+  node_pool_release(list->pool);
+  list_free_header(list);
 }
 
 /**
@@ -185,165 +895,5690 @@ bool sentinel_list_append(SentinelLinkedList *sentinel_list, Node *newTail) {
 }
 
 /**
- * @brief Insert an element at a specific index.
+ * @brief Link a node into the ring right before another one.
  * @param sentinel_list Pointer to the sentinel list.
- * @param index Index at which to insert the element.
- * @param newNode Pointer to the Node struct to insert.
- * @return true on success, false on failure (e.g., index out of bounds).
+ * @param nextNode Node that will follow the new node (sentinel to append).
+ * @param index Index the new node ends up at.
+ * @param newNode Pointer to the Node struct to link.
  */
-bool sentinel_list_insert(SentinelLinkedList *sentinel_list, size_t index,
-                          Node *newNode) {
-  // Index is out of bounds
-  // GCOVR_EXCL_START
-  if (index < 0 || index > sentinel_list_size(sentinel_list))
-    return false;
-  // GCOVR_EXCL_STOP
-  //
-  Node *nodeAtGivenIndex = sentinel_list_get(sentinel_list, index);
-  // Node was not found
-  // GCOVR_EXCL_START
-  if (!nodeAtGivenIndex)
-    return false;
-  // GCOVR_EXCL_STOP
-
-  Node *oldPrev = nodeAtGivenIndex->prev;
+void sentinel_list_link_before(SentinelLinkedList *sentinel_list,
+                               Node *nextNode, size_t index, Node *newNode) {
+  Node *oldPrev = nextNode->prev;
   // Found Node Prev <-> New Node
   newNode->prev = oldPrev;
   oldPrev->next = newNode;
   // New Node <-> Found Node
-  newNode->next = nodeAtGivenIndex;
-  nodeAtGivenIndex->prev = newNode;
+  newNode->next = nextNode;
+  nextNode->prev = newNode;
 
-  // Update list data as needed
-  sentinel_list->tail =
-      (sentinel_list_size(sentinel_list) == 0) ? newNode : sentinel_list->tail;
+  // Linking before the sentinel makes a new tail
+  if (nextNode == sentinel_list->head)
+    sentinel_list->tail = newNode;
   sentinel_list->size += 1;
 
-  // GCOVR_EXCL_START
-  return true;
-  // GCOVR_EXCL_STOP
+  // Later lookups are likely to be near the edit
+  sentinel_list->finger = newNode;
+  sentinel_list->finger_index = index;
 }
 
 /**
- * @brief Remove an element at a specific index.
+ * @brief Unlink a node from the ring.
  * @param sentinel_list Pointer to the sentinel list.
- * @param index Index of the element to remove.
- * @return Pointer to the element, or NULL if index is out of bounds.
+ * @param node Pointer to the (non-sentinel) Node struct to unlink.
+ * @param index Index of the node being unlinked.
  */
-void *sentinel_list_remove(SentinelLinkedList *sentinel_list, size_t index) {
-  // Index is out of bounds
-  // GCOVR_EXCL_START
-  if (!index_in_bounds(sentinel_list_size(sentinel_list), index)) {
-    return NULL;
-  } // GCOVR_EXCL_STOP
-
-  Node *nodeAtGivenIndex = sentinel_list_get(sentinel_list, index);
-  // Node was not found
-  if (!nodeAtGivenIndex) { // GCOVR_EXCL_START
-    return NULL;
-  } // GCOVR_EXCL_STOP
-
-  // "Remove" node at given index
-  Node *prevOfFoundNode = nodeAtGivenIndex->prev;
-  Node *nextOfFoundNode = nodeAtGivenIndex->next;
+void sentinel_list_unlink(SentinelLinkedList *sentinel_list, Node *node,
+                          size_t index) {
+  Node *prevOfFoundNode = node->prev;
+  Node *nextOfFoundNode = node->next;
   // Prev of Node to Remove <-> Next of Node to Remove
   prevOfFoundNode->next = nextOfFoundNode;
   nextOfFoundNode->prev = prevOfFoundNode;
 
   // Update list data as needed
   sentinel_list->size -= 1;
-  if (nodeAtGivenIndex == sentinel_list->tail)
+  if (node == sentinel_list->tail)
     sentinel_list->tail = prevOfFoundNode;
 
-  // NOTE: Function returns pointer, so maybe don't clean
-  // (avoids dangling pointer)
-  return nodeAtGivenIndex;
+  // The following node slides into the removed index
+  sentinel_list->finger =
+      (nextOfFoundNode != sentinel_list->head) ? nextOfFoundNode : NULL;
+  sentinel_list->finger_index = index;
 }
 
-/*
- * =================
- * PRIMARY FUNCTIONS
- * =================
+/**
+ * @brief Insert an element at a specific index.
+ * @param sentinel_list Pointer to the sentinel list.
+ * @param index Index at which to insert the element.
+ * @param newNode Pointer to the Node struct to insert.
+ * @return true on success, false on failure (e.g., index out of bounds).
  */
-
-List *list_create(ListType type) {
+bool sentinel_list_insert(SentinelLinkedList *sentinel_list, size_t index,
+                          Node *newNode) {
+  // Index is out of bounds (index == size appends before the sentinel)
+  Node *nodeAtGivenIndex = sentinel_list_find(sentinel_list, index);
+  if (!nodeAtGivenIndex)
+    return false;
+
+  sentinel_list_link_before(sentinel_list, nodeAtGivenIndex, index, newNode);
+
+  return true;
+}
+
+/**
+ * @brief Insert a batch of nodes at a specific index, linking the whole batch
+ * into the ring in one pass.
+ * @param sentinel_list Pointer to the sentinel list.
+ * @param index Index at which the first node is inserted.
+ * @param nodes Array of pointers to the Node structs to insert.
+ * @param count Number of nodes.
+ * @return true on success, false on failure (e.g., index out of bounds).
+ */
+bool sentinel_list_insert_many(SentinelLinkedList *sentinel_list, size_t index,
+                               void **nodes, size_t count) {
+  Node *nextNode = sentinel_list_find(sentinel_list, index);
+  if (!nextNode)
+    return false;
+  if (count == 0)
+    return true;
+
+  // Chain the batch behind the node before the insertion point
+  Node *prevNode = nextNode->prev;
+  for (size_t i = 0; i < count; i++) {
+    Node *newNode = nodes[i];
+    newNode->prev = prevNode;
+    prevNode->next = newNode;
+    prevNode = newNode;
+  }
+  prevNode->next = nextNode;
+  nextNode->prev = prevNode;
+
+  // Update list data once for the whole batch
+  if (nextNode == sentinel_list->head)
+    sentinel_list->tail = prevNode;
+  sentinel_list->size += count;
+  sentinel_list->finger = nodes[0];
+  sentinel_list->finger_index = index;
+
+  return true;
+}
+
+/**
+ * @brief Move every node of `src` into `dst` at a specific index by relinking
+ * the donor ring in place.
+ * @param dst Pointer to the sentinel list receiving the nodes.
+ * @param index Index in `dst` at which the first donor node lands.
+ * @param src Pointer to the donor sentinel list (left empty).
+ * @return true on success, false on failure (e.g., index out of bounds).
+ */
+bool sentinel_list_splice(SentinelLinkedList *dst, size_t index,
+                          SentinelLinkedList *src) {
+  Node *nextNode = sentinel_list_find(dst, index);
+  if (!nextNode)
+    return false;
+  if (sentinel_list_size(src) == 0)
+    return true;
+
+  Node *first = src->head->next, *last = src->tail;
+  Node *prevNode = nextNode->prev;
+  // Prev <-> First donor ... Last donor <-> Next
+  prevNode->next = first;
+  first->prev = prevNode;
+  last->next = nextNode;
+  nextNode->prev = last;
+
+  if (nextNode == dst->head)
+    dst->tail = last;
+  dst->size += sentinel_list_size(src);
+  dst->finger = first;
+  dst->finger_index = index;
+
+  sentinel_list_reset(src);
+  return true;
+}
+
+/**
+ * @brief Move the nodes from a specific index onwards into an empty sentinel
+ * list by cutting the ring in place.
+ * @param sentinel_list Pointer to the sentinel list being split.
+ * @param index Index of the first node moved.
+ * @param suffix Pointer to the (empty) sentinel list receiving the nodes.
+ * @return true on success, false on failure (e.g., index out of bounds).
+ */
+bool sentinel_list_split_at(SentinelLinkedList *sentinel_list, size_t index,
+                            SentinelLinkedList *suffix) {
+  Node *first = sentinel_list_find(sentinel_list, index);
+  if (!first)
+    return false;
+  if (first == sentinel_list->head)
+    return true;
+
+  Node *last = sentinel_list->tail, *newTail = first->prev;
+  // Suffix Sentinel <-> First ... Last <-> Suffix Sentinel
+  suffix->head->next = first;
+  first->prev = suffix->head;
+  last->next = suffix->head;
+  suffix->head->prev = last;
+  suffix->tail = last;
+  suffix->size = sentinel_list_size(sentinel_list) - index;
+  suffix->finger = first;
+  suffix->finger_index = 0;
+
+  // New Tail <-> Sentinel
+  newTail->next = sentinel_list->head;
+  sentinel_list->head->prev = newTail;
+  sentinel_list->tail = newTail;
+  sentinel_list->size = index;
+  if (sentinel_list->finger_index >= index)
+    sentinel_list->finger = NULL;
+
+  return true;
+}
+
+/**
+ * @brief Remove an element at a specific index.
+ * @param sentinel_list Pointer to the sentinel list.
+ * @param index Index of the element to remove.
+ * @return Pointer to the element, or NULL if index is out of bounds.
+ */
+void *sentinel_list_remove(SentinelLinkedList *sentinel_list, size_t index) {
+  // Index is out of bounds
+  if (!index_in_bounds(sentinel_list_size(sentinel_list), index))
+    return NULL;
+
+  // "Remove" node at given index
+  Node *nodeAtGivenIndex = sentinel_list_find(sentinel_list, index);
+  sentinel_list_unlink(sentinel_list, nodeAtGivenIndex, index);
+
+  // NOTE: Function returns pointer, so maybe don't clean
+  // (avoids dangling pointer)
+  return nodeAtGivenIndex;
+}
+
+/**
+ * @brief Link a node in right after the sentinel in O(1).
+ * @param sentinel_list Pointer to the sentinel list.
+ * @param newHead Pointer to the Node struct to link.
+ * @return true on success.
+ */
+bool sentinel_list_push_front(SentinelLinkedList *sentinel_list,
+                              Node *newHead) {
+  sentinel_list_link_before(sentinel_list, sentinel_list->head->next, 0,
+                            newHead);
+  return true;
+}
+
+/**
+ * @brief Unlink the first node in O(1).
+ * @param sentinel_list Pointer to the sentinel list.
+ * @return Pointer to the node, or NULL if the list is empty.
+ */
+void *sentinel_list_pop_front(SentinelLinkedList *sentinel_list) {
+  if (sentinel_list->size == 0)
+    return NULL;
+
+  Node *oldHead = sentinel_list->head->next;
+  sentinel_list_unlink(sentinel_list, oldHead, 0);
+  return oldHead;
+}
+
+/**
+ * @brief Unlink the last node in O(1).
+ * @param sentinel_list Pointer to the sentinel list.
+ * @return Pointer to the node, or NULL if the list is empty.
+ */
+void *sentinel_list_pop_back(SentinelLinkedList *sentinel_list) {
+  if (sentinel_list->size == 0)
+    return NULL;
+
+  Node *oldTail = sentinel_list->tail;
+  sentinel_list_unlink(sentinel_list, oldTail, sentinel_list->size - 1);
+  return oldTail;
+}
+
+void *sentinel_list_peek_front(const SentinelLinkedList *sentinel_list) {
+  return (sentinel_list->size > 0) ? sentinel_list->head->next : NULL;
+}
+
+void *sentinel_list_peek_back(const SentinelLinkedList *sentinel_list) {
+  return (sentinel_list->size > 0) ? sentinel_list->tail : NULL;
+}
+
+/**
+ * @brief Merge two sorted NULL-terminated chains (linked through next only).
+ * Ties take the node from `first`, so merging an earlier run with a later one
+ * is stable.
+ * @param first Chain of the earlier elements.
+ * @param second Chain of the later elements.
+ * @param cmp Comparison function.
+ * @return The merged chain.
+ */
+Node *sentinel_chain_merge(Node *first, Node *second, ListCompareFunc cmp) {
+  Node merged;
+  Node *tail = &merged;
+  while (first && second) {
+    if (cmp(second, first) < 0) {
+      tail->next = second;
+      second = second->next;
+    } else {
+      tail->next = first;
+      first = first->next;
+    }
+    tail = tail->next;
+  }
+  tail->next = (first) ? first : second;
+  return merged.next;
+}
+
+/**
+ * @brief Stable bottom-up merge sort of a NULL-terminated chain, without
+ * allocating: runs of 2^i nodes wait in runs[i] and merge like the carries
+ * of a binary counter.
+ * @param chain Chain to sort (linked through next only).
+ * @param cmp Comparison function.
+ * @return The sorted chain (prev pointers are left stale).
+ */
+Node *sentinel_chain_sort(Node *chain, ListCompareFunc cmp) {
+  Node *runs[64] = {NULL};
+  while (chain) {
+    Node *run = chain;
+    chain = chain->next;
+    run->next = NULL;
+    size_t level = 0;
+    // Higher levels hold earlier nodes, so they go first
+    for (; runs[level]; level++) {
+      run = sentinel_chain_merge(runs[level], run, cmp);
+      runs[level] = NULL;
+    }
+    runs[level] = run;
+  }
+
+  Node *sorted = NULL;
+  for (size_t level = 0; level < 64; level++) {
+    if (runs[level])
+      sorted = sentinel_chain_merge(runs[level], sorted, cmp);
+  }
+  return sorted;
+}
+
+/**
+ * @brief Close the ring after every node was relinked in a new order, up to
+ * `last`: make it the tail and clear the finger, since any node may have
+ * moved.
+ * @param sentinel_list Pointer to the sentinel list.
+ * @param last The last node (the sentinel if the list is empty).
+ */
+void sentinel_list_close(SentinelLinkedList *sentinel_list, Node *last) {
+  last->next = sentinel_list->head;
+  sentinel_list->head->prev = last;
+  sentinel_list->tail = last;
+  sentinel_list->finger = NULL;
+  sentinel_list->finger_index = 0;
+}
+
+/**
+ * @brief Link a chain holding every node of the list back into the ring,
+ * restoring prev pointers and the tail in one pass.
+ * @param sentinel_list Pointer to the sentinel list.
+ * @param chain The nodes in their new order (linked through next only).
+ */
+void sentinel_list_relink(SentinelLinkedList *sentinel_list, Node *chain) {
+  Node *prev = sentinel_list->head;
+  for (Node *node = chain; node; node = node->next) {
+    prev->next = node;
+    node->prev = prev;
+    prev = node;
+  }
+  sentinel_list_close(sentinel_list, prev);
+}
+
+/**
+ * @brief Sort the list in place by relinking its nodes (stable, no
+ * allocation).
+ * @param sentinel_list Pointer to the sentinel list.
+ * @param cmp Comparison function.
+ */
+void sentinel_list_sort(SentinelLinkedList *sentinel_list,
+                        ListCompareFunc cmp) {
+  if (sentinel_list->size < 2)
+    return;
+  // Cut the ring open after the tail
+  sentinel_list->tail->next = NULL;
+  sentinel_list_relink(sentinel_list,
+                       sentinel_chain_sort(sentinel_list->head->next, cmp));
+}
+
+/*
+ * ==========
+ * ARRAY LIST
+ * ==========
+ */
+
+// First buffer size handed out on the first insertion (doubles afterwards)
+#define ARRAY_LIST_INITIAL_CAPACITY 8
+
+/**
+ * @brief Create a new array backed list.
+ * @param storage Caller-provided storage for the list, or NULL to allocate.
+ * @param allocator Allocation options, or NULL for the defaults.
+ * @return Pointer to the newly created list, or NULL on failure.
+ */
+List *array_list_create(List *storage, const ListAllocator *allocator) {
+  List *list = list_alloc_header(storage, LIST_ARRAY, allocator);
+  if (!list)
+    return NULL;
+
+  list->lists.array_list.allocator = &list->allocator;
+
+  // Buffer is allocated lazily so empty lists stay cheap
+  list->lists.array_list.items = NULL;
+  list->lists.array_list.size = list->lists.array_list.capacity = 0;
+
+  return list;
+}
+
+/**
+ * @brief Remove every element, keeping the buffer for reuse.
+ * @param list Pointer to the list to clear.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void array_list_clear(List *list, FreeFunc free_func) {
+  ArrayList *array_list = &list->lists.array_list;
+
+  if (free_func) {
+    for (size_t i = 0; i < array_list->size; i++)
+      free_func(array_list->items[i]);
+  }
+  array_list->size = 0;
+}
+
+/**
+ * @brief Destroy the array list and free all associated memory.
+ * @param list Pointer to the list to destroy.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void array_list_destroy(List *list, FreeFunc free_func) {
+  array_list_clear(list, free_func);
+  list_mem_free(&list->allocator, list->lists.array_list.items);
+  list_free_header(list);
+}
+
+/**
+ * @brief Make sure the buffer can hold at least `needed` elements.
+ * @param array_list Pointer to the array list.
+ * @param needed Minimum capacity required.
+ * @return true on success, false if the buffer could not be grown.
+ */
+bool array_list_reserve(ArrayList *array_list, size_t needed) {
+  if (needed <= array_list->capacity)
+    return true;
+
+  // Geometric growth keeps appends amortized O(1)
+  size_t capacity = (array_list->capacity) ? array_list->capacity
+                                           : ARRAY_LIST_INITIAL_CAPACITY;
+  while (capacity < needed)
+    capacity *= 2;
+
+  void **items = list_mem_resize(array_list->allocator, array_list->items,
+                                 array_list->capacity * sizeof(void *),
+                                 capacity * sizeof(void *));
+  if (!items)
+    return false;
+
+  array_list->items = items;
+  array_list->capacity = capacity;
+  return true;
+}
+
+/**
+ * @brief Insert an element at a specific index, shifting the tail up.
+ * @param array_list Pointer to the array list.
+ * @param index Index at which to insert the element.
+ * @param data Pointer to the data to insert.
+ * @return true on success, false on failure (e.g., index out of bounds).
+ */
+bool array_list_insert(ArrayList *array_list, size_t index, void *data) {
+  if (!data || index > array_list->size)
+    return false;
+  if (!array_list_reserve(array_list, array_list->size + 1))
+    return false;
+
+  memmove(&array_list->items[index + 1], &array_list->items[index],
+          (array_list->size - index) * sizeof(void *));
+  array_list->items[index] = data;
+  array_list->size += 1;
+
+  return true;
+}
+
+/**
+ * @brief Append an element to the end of the array list.
+ * @param array_list Pointer to the array list.
+ * @param data Pointer to the data to append.
+ * @return true on success, false on failure.
+ */
+bool array_list_append(ArrayList *array_list, void *data) {
+  return array_list_insert(array_list, array_list->size, data);
+}
+
+/**
+ * @brief Insert a batch of elements with one shift of the tail.
+ * @param array_list Pointer to the array list.
+ * @param index Index at which the first element is inserted.
+ * @param items Array of pointers to the data to insert.
+ * @param count Number of elements.
+ * @return true on success, false on failure (e.g., index out of bounds).
+ */
+bool array_list_insert_many(ArrayList *array_list, size_t index, void **items,
+                            size_t count) {
+  if (index > array_list->size)
+    return false;
+  if (count == 0)
+    return true;
+  if (!array_list_reserve(array_list, array_list->size + count))
+    return false;
+
+  memmove(&array_list->items[index + count], &array_list->items[index],
+          (array_list->size - index) * sizeof(void *));
+  memcpy(&array_list->items[index], items, count * sizeof(void *));
+  array_list->size += count;
+
+  return true;
+}
+
+/**
+ * @brief Move every element of `src` into `dst` at a specific index.
+ * @param dst Pointer to the array list receiving the elements.
+ * @param index Index in `dst` at which the first donor element lands.
+ * @param src Pointer to the donor array list (left empty, buffer kept).
+ * @return true on success, false on failure (e.g., index out of bounds).
+ */
+bool array_list_splice(ArrayList *dst, size_t index, ArrayList *src) {
+  if (!array_list_insert_many(dst, index, src->items, src->size))
+    return false;
+  src->size = 0;
+  return true;
+}
+
+/**
+ * @brief Move the elements from a specific index onwards into another array.
+ * @param array_list Pointer to the array list being split.
+ * @param index Index of the first element moved.
+ * @param suffix Pointer to the (empty) array list receiving the elements.
+ * @return true on success, false on failure (e.g., index out of bounds).
+ */
+bool array_list_split_at(ArrayList *array_list, size_t index,
+                         ArrayList *suffix) {
+  if (index > array_list->size)
+    return false;
+  if (!array_list_insert_many(suffix, 0, &array_list->items[index],
+                              array_list->size - index))
+    return false;
+  array_list->size = index;
+  return true;
+}
+
+/**
+ * @brief Remove an element at a specific index, shifting the tail down.
+ * @param array_list Pointer to the array list.
+ * @param index Index of the element to remove.
+ * @return Pointer to the element, or NULL if index is out of bounds.
+ */
+void *array_list_remove(ArrayList *array_list, size_t index) {
+  if (!index_in_bounds(array_list->size, index))
+    return NULL;
+
+  void *data = array_list->items[index];
+  memmove(&array_list->items[index], &array_list->items[index + 1],
+          (array_list->size - index - 1) * sizeof(void *));
+  array_list->size -= 1;
+
+  return data;
+}
+
+/**
+ * @brief Remove the last element in O(1) (nothing to shift).
+ * @param array_list Pointer to the array list.
+ * @return Pointer to the element, or NULL if the list is empty.
+ */
+void *array_list_pop_back(ArrayList *array_list) {
+  if (array_list->size == 0)
+    return NULL;
+  return array_list->items[--array_list->size];
+}
+
+/**
+ * @brief Get the element at a specific index in O(1).
+ * @param array_list Pointer to the array list.
+ * @param index Index of the element to retrieve.
+ * @return Pointer to the element, or NULL if index is out of bounds.
+ */
+void *array_list_get(const ArrayList *array_list, size_t index) {
+  if (!index_in_bounds(array_list->size, index))
+    return NULL;
+  return array_list->items[index];
+}
+
+size_t array_list_size(const ArrayList *array_list) {
+  return array_list->size;
+}
+
+/*
+ * ===============
+ * GAP BUFFER LIST
+ * ===============
+ */
+
+// First buffer size handed out on the first insertion (doubles afterwards)
+#define GAP_BUFFER_INITIAL_CAPACITY 16
+
+/**
+ * @brief Create a new gap buffer list.
+ * @param storage Caller-provided storage for the list, or NULL to allocate.
+ * @param allocator Allocation options, or NULL for the defaults.
+ * @return Pointer to the newly created list, or NULL on failure.
+ */
+List *gap_list_create(List *storage, const ListAllocator *allocator) {
+  List *list = list_alloc_header(storage, LIST_GAP_BUFFER, allocator);
+  if (!list)
+    return NULL;
+
+  list->lists.gap_list.allocator = &list->allocator;
+
+  // Buffer is allocated lazily; an empty buffer is all gap
+  list->lists.gap_list.items = NULL;
+  list->lists.gap_list.capacity = list->lists.gap_list.gap_start =
+      list->lists.gap_list.gap_end = 0;
+
+  return list;
+}
+
+size_t gap_list_size(const GapBufferList *gap_list) {
+  return gap_list->capacity - (gap_list->gap_end - gap_list->gap_start);
+}
+
+/**
+ * @brief Remove every element, keeping the buffer for reuse.
+ * @param list Pointer to the list to clear.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void gap_list_clear(List *list, FreeFunc free_func) {
+  GapBufferList *gap_list = &list->lists.gap_list;
+
+  if (free_func) {
+    for (size_t i = 0; i < gap_list->gap_start; i++)
+      free_func(gap_list->items[i]);
+    for (size_t i = gap_list->gap_end; i < gap_list->capacity; i++)
+      free_func(gap_list->items[i]);
+  }
+
+  // The whole buffer becomes the gap
+  gap_list->gap_start = 0;
+  gap_list->gap_end = gap_list->capacity;
+}
+
+/**
+ * @brief Destroy the gap buffer list and free all associated memory.
+ * @param list Pointer to the list to destroy.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void gap_list_destroy(List *list, FreeFunc free_func) {
+  gap_list_clear(list, free_func);
+  list_mem_free(&list->allocator, list->lists.gap_list.items);
+  list_free_header(list);
+}
+
+/**
+ * @brief Move the gap so it starts at `index`.
+ * @param gap_list Pointer to the gap buffer list.
+ * @param index Logical index the gap should start at (<= size).
+ *
+ * Only the elements between the old and new gap position are moved, so a run
+ * of edits around one cursor costs O(1) per edit.
+ */
+void gap_list_move_gap(GapBufferList *gap_list, size_t index) {
+  if (index < gap_list->gap_start) {
+    // Slide [index, gap_start) to just before gap_end
+    size_t count = gap_list->gap_start - index;
+    memmove(&gap_list->items[gap_list->gap_end - count],
+            &gap_list->items[index], count * sizeof(void *));
+    gap_list->gap_start -= count;
+    gap_list->gap_end -= count;
+  } else if (index > gap_list->gap_start) {
+    // Slide [gap_end, gap_end + count) down to gap_start
+    size_t count = index - gap_list->gap_start;
+    memmove(&gap_list->items[gap_list->gap_start],
+            &gap_list->items[gap_list->gap_end], count * sizeof(void *));
+    gap_list->gap_start += count;
+    gap_list->gap_end += count;
+  }
+}
+
+/**
+ * @brief Grow the buffer once the gap is used up.
+ * @param gap_list Pointer to the gap buffer list.
+ * @return true on success, false if the buffer could not be grown.
+ */
+bool gap_list_grow(GapBufferList *gap_list) {
+  size_t capacity = (gap_list->capacity) ? gap_list->capacity * 2
+                                         : GAP_BUFFER_INITIAL_CAPACITY;
+  void **items = list_mem_resize(gap_list->allocator, gap_list->items,
+                                 gap_list->capacity * sizeof(void *),
+                                 capacity * sizeof(void *));
+  if (!items)
+    return false;
+
+  // Keep the suffix at the end of the (larger) buffer so the gap widens
+  size_t suffix = gap_list->capacity - gap_list->gap_end;
+  memmove(&items[capacity - suffix], &items[gap_list->gap_end],
+          suffix * sizeof(void *));
+
+  gap_list->items = items;
+  gap_list->gap_end = capacity - suffix;
+  gap_list->capacity = capacity;
+  return true;
+}
+
+/**
+ * @brief Insert an element at a specific index.
+ * @param gap_list Pointer to the gap buffer list.
+ * @param index Index at which to insert the element.
+ * @param data Pointer to the data to insert.
+ * @return true on success, false on failure (e.g., index out of bounds).
+ */
+bool gap_list_insert(GapBufferList *gap_list, size_t index, void *data) {
+  if (!data || index > gap_list_size(gap_list))
+    return false;
+  if (gap_list->gap_start == gap_list->gap_end && !gap_list_grow(gap_list))
+    return false;
+
+  gap_list_move_gap(gap_list, index);
+  gap_list->items[gap_list->gap_start++] = data;
+
+  return true;
+}
+
+bool gap_list_append(GapBufferList *gap_list, void *data) {
+  return gap_list_insert(gap_list, gap_list_size(gap_list), data);
+}
+
+/**
+ * @brief Insert a batch of elements by copying them into the gap.
+ * @param gap_list Pointer to the gap buffer list.
+ * @param index Index at which the first element is inserted.
+ * @param items Array of pointers to the data to insert.
+ * @param count Number of elements.
+ * @return true on success, false on failure (e.g., index out of bounds).
+ */
+bool gap_list_insert_many(GapBufferList *gap_list, size_t index, void **items,
+                          size_t count) {
+  if (index > gap_list_size(gap_list))
+    return false;
+  if (count == 0)
+    return true;
+  while (gap_list->gap_end - gap_list->gap_start < count) {
+    if (!gap_list_grow(gap_list))
+      return false;
+  }
+
+  gap_list_move_gap(gap_list, index);
+  memcpy(&gap_list->items[gap_list->gap_start], items,
+         count * sizeof(void *));
+  gap_list->gap_start += count;
+
+  return true;
+}
+
+/**
+ * @brief Move every element of `src` into `dst` at a specific index.
+ * @param dst Pointer to the gap buffer list receiving the elements.
+ * @param index Index in `dst` at which the first donor element lands.
+ * @param src Pointer to the donor gap buffer list (left empty, buffer kept).
+ * @return true on success, false on failure (e.g., index out of bounds).
+ */
+bool gap_list_splice(GapBufferList *dst, size_t index, GapBufferList *src) {
+  // Parking the donor's gap at its end makes its elements contiguous
+  size_t count = gap_list_size(src);
+  gap_list_move_gap(src, count);
+  if (!gap_list_insert_many(dst, index, src->items, count))
+    return false;
+
+  src->gap_start = 0;
+  src->gap_end = src->capacity;
+  return true;
+}
+
+/**
+ * @brief Move the elements from a specific index onwards into another gap
+ * buffer.
+ * @param gap_list Pointer to the gap buffer list being split.
+ * @param index Index of the first element moved.
+ * @param suffix Pointer to the (empty) gap buffer list receiving the elements.
+ * @return true on success, false on failure (e.g., index out of bounds).
+ */
+bool gap_list_split_at(GapBufferList *gap_list, size_t index,
+                       GapBufferList *suffix) {
+  if (index > gap_list_size(gap_list))
+    return false;
+
+  // With the gap at `index` the suffix is the contiguous run after it
+  gap_list_move_gap(gap_list, index);
+  if (!gap_list_insert_many(suffix, 0, &gap_list->items[gap_list->gap_end],
+                            gap_list->capacity - gap_list->gap_end))
+    return false;
+  gap_list->gap_end = gap_list->capacity;
+  return true;
+}
+
+/**
+ * @brief Remove an element at a specific index.
+ * @param gap_list Pointer to the gap buffer list.
+ * @param index Index of the element to remove.
+ * @return Pointer to the element, or NULL if index is out of bounds.
+ */
+void *gap_list_remove(GapBufferList *gap_list, size_t index) {
+  if (!index_in_bounds(gap_list_size(gap_list), index))
+    return NULL;
+
+  // Element at `index` sits right after the gap once it has moved
+  gap_list_move_gap(gap_list, index);
+  return gap_list->items[gap_list->gap_end++];
+}
+
+/**
+ * @brief Get the element at a specific index in O(1).
+ * @param gap_list Pointer to the gap buffer list.
+ * @param index Index of the element to retrieve.
+ * @return Pointer to the element, or NULL if index is out of bounds.
+ */
+void *gap_list_get(const GapBufferList *gap_list, size_t index) {
+  if (!index_in_bounds(gap_list_size(gap_list), index))
+    return NULL;
+
+  // Indices past the gap are offset by its width
+  if (index >= gap_list->gap_start)
+    index += gap_list->gap_end - gap_list->gap_start;
+  return gap_list->items[index];
+}
+
+/*
+ * =============
+ * UNROLLED LIST
+ * =============
+ */
+
+/**
+ * @brief Create a new unrolled list.
+ * @param storage Caller-provided storage for the list, or NULL to allocate.
+ * @param allocator Allocation options, or NULL for the defaults.
+ * @return Pointer to the newly created list, or NULL on failure.
+ */
+List *unrolled_list_create(List *storage, const ListAllocator *allocator) {
+  List *list = list_alloc_header(storage, LIST_UNROLLED, allocator);
+  if (!list)
+    return NULL;
+
+  list->lists.unrolled_list.allocator = &list->allocator;
+
+  // Blocks are allocated on demand
+  list->lists.unrolled_list.head = list->lists.unrolled_list.tail = NULL;
+  list->lists.unrolled_list.size = 0;
+  list->lists.unrolled_list.pool = NULL;
+
+  return list;
+}
+
+size_t unrolled_list_size(const UnrolledList *unrolled_list) {
+  return unrolled_list->size;
+}
+
+/**
+ * @brief Allocate an empty block aligned to a cache line.
+ * @param unrolled_list Pointer to the unrolled list (owns the optional pool).
+ * @return Pointer to the new block, or NULL on failure.
+ */
+UnrolledNode *unrolled_node_create(UnrolledList *unrolled_list) {
+  UnrolledNode *node =
+      (unrolled_list->pool)
+          ? node_pool_alloc(unrolled_list->pool)
+          : list_mem_aligned_alloc(unrolled_list->allocator,
+                                   UNROLLED_CACHE_LINE, sizeof(UnrolledNode));
+  if (!node)
+    return NULL;
+  node->next = node->prev = NULL;
+  node->count = 0;
+  return node;
+}
+
+/**
+ * @brief Release a block to the pool (or the heap without one).
+ * @param unrolled_list Pointer to the unrolled list.
+ * @param node Block to release.
+ */
+void unrolled_node_destroy(UnrolledList *unrolled_list, UnrolledNode *node) {
+  if (unrolled_list->pool)
+    node_pool_free(unrolled_list->pool, node);
+  else
+    list_mem_free(unrolled_list->allocator, node);
+}
+
+/**
+ * @brief Remove every element, keeping the list (and its pool slabs) for reuse.
+ * @param list Pointer to the list to clear.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void unrolled_list_clear(List *list, FreeFunc free_func) {
+  UnrolledList *unrolled_list = &list->lists.unrolled_list;
+  UnrolledNode *currNode = unrolled_list->head;
+
+  // An unshared pool takes every block back at once below
+  bool resetPool = list_owns_pool(list);
+  while (currNode && (free_func || !resetPool)) {
+    UnrolledNode *nextNode = currNode->next;
+    if (free_func) {
+      for (size_t i = 0; i < currNode->count; i++)
+        free_func(currNode->items[i]);
+    }
+    if (!resetPool)
+      unrolled_node_destroy(unrolled_list, currNode);
+    currNode = nextNode;
+  }
+
+  unrolled_list->head = unrolled_list->tail = NULL;
+  unrolled_list->size = 0;
+  if (resetPool)
+    node_pool_reset(list->pool);
+}
+
+/**
+ * @brief Destroy the unrolled list and free all associated memory.
+ * @param list Pointer to the list to destroy.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void unrolled_list_destroy(List *list, FreeFunc free_func) {
+  unrolled_list_clear(list, free_func);
+  node_pool_release(list->pool);
+  list_free_header(list);
+}
+
+/**
+ * @brief Link `node` into the block chain right after `prevNode`.
+ * @param unrolled_list Pointer to the unrolled list.
+ * @param prevNode Block to link after, or NULL to link as the new head.
+ * @param node Block to link.
+ */
+void unrolled_list_link_after(UnrolledList *unrolled_list,
+                              UnrolledNode *prevNode, UnrolledNode *node) {
+  UnrolledNode *nextNode = (prevNode) ? prevNode->next : unrolled_list->head;
+
+  node->prev = prevNode;
+  node->next = nextNode;
+  if (prevNode)
+    prevNode->next = node;
+  else
+    unrolled_list->head = node;
+  if (nextNode)
+    nextNode->prev = node;
+  else
+    unrolled_list->tail = node;
+}
+
+/**
+ * @brief Unlink and free a block.
+ * @param unrolled_list Pointer to the unrolled list.
+ * @param node Block to release (its elements must already be moved).
+ */
+void unrolled_list_unlink(UnrolledList *unrolled_list, UnrolledNode *node) {
+  if (node->prev)
+    node->prev->next = node->next;
+  else
+    unrolled_list->head = node->next;
+  if (node->next)
+    node->next->prev = node->prev;
+  else
+    unrolled_list->tail = node->prev;
+  unrolled_node_destroy(unrolled_list, node);
+}
+
+/**
+ * @brief Find the block holding a given index.
+ * @param unrolled_list Pointer to the unrolled list.
+ * @param index Index to locate; index == size resolves to the end of the tail.
+ * @param offset Out parameter for the slot of `index` inside the block.
+ * @return The block, or NULL if the list is empty or index is out of bounds.
+ */
+UnrolledNode *unrolled_list_find(const UnrolledList *unrolled_list,
+                                 size_t index, size_t *offset) {
+  if (index > unrolled_list->size || !unrolled_list->head)
+    return NULL;
+
+  // Start at tail or head based on which is closest, hopping whole blocks
+  if (index > unrolled_list->size / 2) {
+    UnrolledNode *currNode = unrolled_list->tail;
+    size_t blockStart = unrolled_list->size - currNode->count;
+    while (index < blockStart) {
+      currNode = currNode->prev;
+      blockStart -= currNode->count;
+    }
+    *offset = index - blockStart;
+    return currNode;
+  }
+
+  UnrolledNode *currNode = unrolled_list->head;
+  while (index >= currNode->count && currNode->next) {
+    index -= currNode->count;
+    currNode = currNode->next;
+  }
+  *offset = index;
+  return currNode;
+}
+
+/**
+ * @brief Insert an element at a slot of a block.
+ * @param unrolled_list Pointer to the unrolled list.
+ * @param node Block to insert into (NULL only when the list is empty).
+ * @param offset Slot inside the block (<= its count); updated to the slot of
+ * the new element.
+ * @param data Pointer to the data to insert.
+ * @return The block holding the new element, or NULL on failure.
+ */
+UnrolledNode *unrolled_list_insert_at(UnrolledList *unrolled_list,
+                                      UnrolledNode *node, size_t *offset,
+                                      void *data) {
+  if (!node || node->count == UNROLLED_NODE_CAPACITY) {
+    UnrolledNode *newNode = unrolled_node_create(unrolled_list);
+    if (!newNode)
+      return NULL;
+
+    if (!node) {
+      // First block of an empty list
+      unrolled_list_link_after(unrolled_list, NULL, newNode);
+      node = newNode;
+      *offset = 0;
+    } else if (*offset == node->count) {
+      // Appending past a full block: start a fresh one so blocks stay packed
+      unrolled_list_link_after(unrolled_list, node, newNode);
+      node = newNode;
+      *offset = 0;
+    } else {
+      // Split the full block in half
+      size_t keep = node->count / 2;
+      newNode->count = node->count - keep;
+      memcpy(newNode->items, &node->items[keep],
+             newNode->count * sizeof(void *));
+      node->count = keep;
+      unrolled_list_link_after(unrolled_list, node, newNode);
+      if (*offset > keep) {
+        *offset -= keep;
+        node = newNode;
+      }
+    }
+  }
+
+  memmove(&node->items[*offset + 1], &node->items[*offset],
+          (node->count - *offset) * sizeof(void *));
+  node->items[*offset] = data;
+  node->count += 1;
+  unrolled_list->size += 1;
+
+  return node;
+}
+
+/**
+ * @brief Insert an element at a specific index.
+ * @param unrolled_list Pointer to the unrolled list.
+ * @param index Index at which to insert the element.
+ * @param data Pointer to the data to insert.
+ * @return true on success, false on failure (e.g., index out of bounds).
+ */
+bool unrolled_list_insert(UnrolledList *unrolled_list, size_t index,
+                          void *data) {
+  if (!data || index > unrolled_list->size)
+    return false;
+
+  size_t offset = 0;
+  UnrolledNode *node = unrolled_list_find(unrolled_list, index, &offset);
+  return unrolled_list_insert_at(unrolled_list, node, &offset, data) != NULL;
+}
+
+bool unrolled_list_append(UnrolledList *unrolled_list, void *data) {
+  return unrolled_list_insert(unrolled_list, unrolled_list->size, data);
+}
+
+/**
+ * @brief Insert a batch of elements, locating the insertion point once.
+ * @param unrolled_list Pointer to the unrolled list.
+ * @param index Index at which the first element is inserted.
+ * @param items Array of pointers to the data to insert.
+ * @param count Number of elements.
+ * @return true on success, false on failure (e.g., index out of bounds). An
+ * allocation failure part way leaves the elements inserted so far in place.
+ */
+bool unrolled_list_insert_many(UnrolledList *unrolled_list, size_t index,
+                               void **items, size_t count) {
+  if (index > unrolled_list->size)
+    return false;
+
+  size_t offset = 0;
+  UnrolledNode *node = unrolled_list_find(unrolled_list, index, &offset);
+  for (size_t i = 0; i < count; i++) {
+    node = unrolled_list_insert_at(unrolled_list, node, &offset, items[i]);
+    if (!node)
+      return false;
+    // Next element goes right after this one
+    offset += 1;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Move every element of `src` into `dst` at a specific index by
+ * relinking the donor's blocks (splitting one `dst` block at most).
+ * @param dst Pointer to the unrolled list receiving the elements.
+ * @param index Index in `dst` at which the first donor element lands.
+ * @param src Pointer to the donor unrolled list (left empty).
+ * @return true on success, false on failure (e.g., index out of bounds).
+ */
+bool unrolled_list_splice(UnrolledList *dst, size_t index, UnrolledList *src) {
+  if (index > dst->size)
+    return false;
+  if (!src->head)
+    return true;
+
+  // Find the block the donor chain goes after (NULL: in front of the head)
+  size_t offset = 0;
+  UnrolledNode *prevNode = unrolled_list_find(dst, index, &offset);
+  if (prevNode && offset == 0) {
+    prevNode = prevNode->prev;
+  } else if (prevNode && offset < prevNode->count) {
+    // Split the block so the donor chain can go between its halves
+    UnrolledNode *newNode = unrolled_node_create(dst);
+    if (!newNode)
+      return false;
+    newNode->count = prevNode->count - offset;
+    memcpy(newNode->items, &prevNode->items[offset],
+           newNode->count * sizeof(void *));
+    prevNode->count = offset;
+    unrolled_list_link_after(dst, prevNode, newNode);
+  }
+
+  UnrolledNode *nextNode = (prevNode) ? prevNode->next : dst->head;
+  src->head->prev = prevNode;
+  src->tail->next = nextNode;
+  if (prevNode)
+    prevNode->next = src->head;
+  else
+    dst->head = src->head;
+  if (nextNode)
+    nextNode->prev = src->tail;
+  else
+    dst->tail = src->tail;
+  dst->size += src->size;
+
+  src->head = src->tail = NULL;
+  src->size = 0;
+  return true;
+}
+
+/**
+ * @brief Move the elements from a specific index onwards into an empty
+ * unrolled list by relinking blocks (splitting one block at most).
+ * @param unrolled_list Pointer to the unrolled list being split.
+ * @param index Index of the first element moved.
+ * @param suffix Pointer to the (empty) unrolled list receiving the elements.
+ * @return true on success, false on failure (e.g., index out of bounds).
+ */
+bool unrolled_list_split_at(UnrolledList *unrolled_list, size_t index,
+                            UnrolledList *suffix) {
+  if (index > unrolled_list->size)
+    return false;
+  if (index == unrolled_list->size)
+    return true;
+
+  size_t offset = 0;
+  UnrolledNode *first = unrolled_list_find(unrolled_list, index, &offset);
+  if (offset > 0) {
+    // Split the block so the suffix starts on a block boundary
+    UnrolledNode *newNode = unrolled_node_create(unrolled_list);
+    if (!newNode)
+      return false;
+    newNode->count = first->count - offset;
+    memcpy(newNode->items, &first->items[offset],
+           newNode->count * sizeof(void *));
+    first->count = offset;
+    unrolled_list_link_after(unrolled_list, first, newNode);
+    first = newNode;
+  }
+
+  suffix->head = first;
+  suffix->tail = unrolled_list->tail;
+  suffix->size = unrolled_list->size - index;
+  unrolled_list->tail = first->prev;
+  if (first->prev)
+    first->prev->next = NULL;
+  else
+    unrolled_list->head = NULL;
+  first->prev = NULL;
+  unrolled_list->size = index;
+
+  return true;
+}
+
+/**
+ * @brief Merge the block after `node` into `node` when both fit in one.
+ * @param unrolled_list Pointer to the unrolled list.
+ * @param node Block to merge into.
+ */
+void unrolled_list_merge_next(UnrolledList *unrolled_list, UnrolledNode *node) {
+  UnrolledNode *nextNode = node->next;
+  if (!nextNode || node->count + nextNode->count > UNROLLED_NODE_CAPACITY)
+    return;
+
+  memcpy(&node->items[node->count], nextNode->items,
+         nextNode->count * sizeof(void *));
+  node->count += nextNode->count;
+  unrolled_list_unlink(unrolled_list, nextNode);
+}
+
+/**
+ * @brief Remove the element at a slot of a block.
+ * @param unrolled_list Pointer to the unrolled list.
+ * @param node Block holding the element; updated to the block holding the
+ * element that followed it (the tail at the end, NULL once empty).
+ * @param offset Slot of the element; updated to the following element's slot.
+ * @return Pointer to the removed element.
+ */
+void *unrolled_list_remove_at(UnrolledList *unrolled_list, UnrolledNode **node,
+                              size_t *offset) {
+  UnrolledNode *currNode = *node;
+  size_t currOffset = *offset;
+  void *data = currNode->items[currOffset];
+
+  memmove(&currNode->items[currOffset], &currNode->items[currOffset + 1],
+          (currNode->count - currOffset - 1) * sizeof(void *));
+  currNode->count -= 1;
+  unrolled_list->size -= 1;
+
+  // Keep blocks at least half full by merging with a neighbour
+  if (currNode->count == 0) {
+    UnrolledNode *nextNode = currNode->next, *prevNode = currNode->prev;
+    unrolled_list_unlink(unrolled_list, currNode);
+    currNode = (nextNode) ? nextNode : prevNode;
+    currOffset = (nextNode || !prevNode) ? 0 : prevNode->count;
+  } else if (currNode->count < UNROLLED_NODE_CAPACITY / 2) {
+    UnrolledNode *prevNode = currNode->prev;
+    if (currNode->next) {
+      unrolled_list_merge_next(unrolled_list, currNode);
+    } else if (prevNode &&
+               prevNode->count + currNode->count <= UNROLLED_NODE_CAPACITY) {
+      currOffset += prevNode->count;
+      unrolled_list_merge_next(unrolled_list, prevNode);
+      currNode = prevNode;
+    }
+  }
+
+  // One past a block's last slot is the next block's first slot
+  if (currNode && currOffset == currNode->count && currNode->next) {
+    currNode = currNode->next;
+    currOffset = 0;
+  }
+
+  *node = currNode;
+  *offset = currOffset;
+  return data;
+}
+
+/**
+ * @brief Remove an element at a specific index.
+ * @param unrolled_list Pointer to the unrolled list.
+ * @param index Index of the element to remove.
+ * @return Pointer to the element, or NULL if index is out of bounds.
+ */
+void *unrolled_list_remove(UnrolledList *unrolled_list, size_t index) {
+  if (!index_in_bounds(unrolled_list->size, index))
+    return NULL;
+
+  size_t offset = 0;
+  UnrolledNode *node = unrolled_list_find(unrolled_list, index, &offset);
+  return unrolled_list_remove_at(unrolled_list, &node, &offset);
+}
+
+/**
+ * @brief Insert an element before the first one, straight into the head
+ * block.
+ * @param unrolled_list Pointer to the unrolled list.
+ * @param data Pointer to the data to insert.
+ * @return true on success, false on failure.
+ */
+bool unrolled_list_push_front(UnrolledList *unrolled_list, void *data) {
+  if (!data)
+    return false;
+
+  size_t offset = 0;
+  return unrolled_list_insert_at(unrolled_list, unrolled_list->head, &offset,
+                                 data) != NULL;
+}
+
+void *unrolled_list_pop_front(UnrolledList *unrolled_list) {
+  if (unrolled_list->size == 0)
+    return NULL;
+
+  size_t offset = 0;
+  UnrolledNode *node = unrolled_list->head;
+  return unrolled_list_remove_at(unrolled_list, &node, &offset);
+}
+
+void *unrolled_list_pop_back(UnrolledList *unrolled_list) {
+  if (unrolled_list->size == 0)
+    return NULL;
+
+  UnrolledNode *node = unrolled_list->tail;
+  size_t offset = node->count - 1;
+  return unrolled_list_remove_at(unrolled_list, &node, &offset);
+}
+
+/**
+ * @brief Get the element at a specific index.
+ * @param unrolled_list Pointer to the unrolled list.
+ * @param index Index of the element to retrieve.
+ * @return Pointer to the element, or NULL if index is out of bounds.
+ */
+void *unrolled_list_get(const UnrolledList *unrolled_list, size_t index) {
+  if (!index_in_bounds(unrolled_list->size, index))
+    return NULL;
+
+  size_t offset = 0;
+  UnrolledNode *node = unrolled_list_find(unrolled_list, index, &offset);
+  return node->items[offset];
+}
+
+/*
+ * =========
+ * SKIP LIST
+ * =========
+ */
+
+/**
+ * @brief Allocate a skip list node with `level` forward links.
+ * @param allocator Allocator the node comes from.
+ * @return Pointer to the new node, or NULL on failure.
+ */
+SkipNode *skip_node_create(const ListAllocator *allocator, void *data,
+                           size_t level) {
+  SkipNode *node =
+      list_mem_alloc(allocator, sizeof(SkipNode) + level * sizeof(SkipLink));
+  if (!node)
+    return NULL;
+  node->data = data;
+  node->level = level;
+  return node;
+}
+
+/**
+ * @brief Create a new skip list.
+ * @param storage Caller-provided storage for the list, or NULL to allocate.
+ * @param allocator Allocation options, or NULL for the defaults.
+ * @return Pointer to the newly created list, or NULL on failure.
+ */
+List *skip_list_create(List *storage, const ListAllocator *allocator) {
+  List *list = list_alloc_header(storage, LIST_SKIP, allocator);
+  if (!list)
+    return NULL;
+
+  SkipList *skip_list = &list->lists.skip_list;
+  SkipNode *head =
+      skip_node_create(&list->allocator, NULL, SKIP_LIST_MAX_LEVEL);
+  if (!head) {
+    list_free_header(list);
+    return NULL;
+  }
+  skip_list->allocator = &list->allocator;
+
+  // Empty list: the head's only link spans to the end (one step away)
+  head->prev = NULL;
+  head->links[0].next = NULL;
+  head->links[0].width = 1;
+  skip_list->head = head;
+  skip_list->size = 0;
+  skip_list->level = 1;
+  // Fixed seed keeps level choices (and so performance) reproducible
+  skip_list->seed = 0x9E3779B97F4A7C15ULL;
+
+  return list;
+}
+
+size_t skip_list_size(const SkipList *skip_list) { return skip_list->size; }
+
+/**
+ * @brief Remove every element, keeping the list (and its head node) for reuse.
+ * @param list Pointer to the list to clear.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void skip_list_clear(List *list, FreeFunc free_func) {
+  SkipList *skip_list = &list->lists.skip_list;
+  SkipNode *currNode = skip_list->head->links[0].next;
+
+  while (currNode) {
+    SkipNode *nextNode = currNode->links[0].next;
+    if (free_func)
+      free_func(currNode->data);
+    list_mem_free(&list->allocator, currNode);
+    currNode = nextNode;
+  }
+
+  // Back to the freshly created shape (the seed carries on)
+  skip_list->head->links[0].next = NULL;
+  skip_list->head->links[0].width = 1;
+  skip_list->size = 0;
+  skip_list->level = 1;
+}
+
+/**
+ * @brief Destroy the skip list and free all associated memory.
+ * @param list Pointer to the list to destroy.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void skip_list_destroy(List *list, FreeFunc free_func) {
+  skip_list_clear(list, free_func);
+  list_mem_free(&list->allocator, list->lists.skip_list.head);
+  list_free_header(list);
+}
+
+/**
+ * @brief Pick a level for a new node (geometric, p = 1/4).
+ * @param skip_list Pointer to the skip list (owns the xorshift state).
+ * @return Level in [1, SKIP_LIST_MAX_LEVEL].
+ */
+size_t skip_list_random_level(SkipList *skip_list) {
+  // xorshift64*
+  uint64_t x = skip_list->seed;
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  skip_list->seed = x;
+  x *= 0x2545F4914F6CDD1DULL;
+
+  size_t level = 1;
+  while (level < SKIP_LIST_MAX_LEVEL && (x & 3) == 0) {
+    level++;
+    x >>= 2;
+  }
+  return level;
+}
+
+/**
+ * @brief Find, on every level, the last node positioned before `index`.
+ * @param skip_list Pointer to the skip list.
+ * @param index Index being looked up.
+ * @param update Out array of predecessors per level.
+ * @param steps Out array of each predecessor's distance from the head.
+ */
+void skip_list_find_predecessors(const SkipList *skip_list, size_t index,
+                                 SkipNode **update, size_t *steps) {
+  SkipNode *node = skip_list->head;
+  size_t traveled = 0;
+
+  for (size_t lvl = skip_list->level; lvl-- > 0;) {
+    while (node->links[lvl].next &&
+           traveled + node->links[lvl].width <= index) {
+      traveled += node->links[lvl].width;
+      node = node->links[lvl].next;
+    }
+    update[lvl] = node;
+    steps[lvl] = traveled;
+  }
+}
+
+/**
+ * @brief Insert an element at a specific index in expected O(log n).
+ * @param skip_list Pointer to the skip list.
+ * @param index Index at which to insert the element.
+ * @param data Pointer to the data to insert.
+ * @return true on success, false on failure (e.g., index out of bounds).
+ */
+bool skip_list_insert(SkipList *skip_list, size_t index, void *data) {
+  if (!data || index > skip_list->size)
+    return false;
+
+  SkipNode *update[SKIP_LIST_MAX_LEVEL] = {NULL};
+  size_t steps[SKIP_LIST_MAX_LEVEL];
+  skip_list_find_predecessors(skip_list, index, update, steps);
+
+  size_t level = skip_list_random_level(skip_list);
+  SkipNode *newNode = skip_node_create(skip_list->allocator, data, level);
+  if (!newNode)
+    return false;
+
+  // Newly used head levels span the whole list
+  for (size_t lvl = skip_list->level; lvl < level; lvl++) {
+    skip_list->head->links[lvl].next = NULL;
+    skip_list->head->links[lvl].width = skip_list->size + 1;
+    update[lvl] = skip_list->head;
+    steps[lvl] = 0;
+  }
+  if (level > skip_list->level)
+    skip_list->level = level;
+
+  // The new node sits index + 1 steps from the head; split the spans that
+  // cross it and widen the ones above it
+  for (size_t lvl = 0; lvl < skip_list->level; lvl++) {
+    SkipLink *link = &update[lvl]->links[lvl];
+    if (lvl < level) {
+      newNode->links[lvl].next = link->next;
+      newNode->links[lvl].width = steps[lvl] + link->width - index;
+      link->next = newNode;
+      link->width = index + 1 - steps[lvl];
+    } else {
+      link->width += 1;
+    }
+  }
+  newNode->prev = update[0];
+  if (newNode->links[0].next)
+    newNode->links[0].next->prev = newNode;
+
+  skip_list->size += 1;
+  return true;
+}
+
+bool skip_list_append(SkipList *skip_list, void *data) {
+  return skip_list_insert(skip_list, skip_list->size, data);
+}
+
+/**
+ * @brief Remove an element at a specific index in expected O(log n).
+ * @param skip_list Pointer to the skip list.
+ * @param index Index of the element to remove.
+ * @return Pointer to the element, or NULL if index is out of bounds.
+ */
+void *skip_list_remove(SkipList *skip_list, size_t index) {
+  if (!index_in_bounds(skip_list->size, index))
+    return NULL;
+
+  SkipNode *update[SKIP_LIST_MAX_LEVEL] = {NULL};
+  size_t steps[SKIP_LIST_MAX_LEVEL];
+  skip_list_find_predecessors(skip_list, index, update, steps);
+  SkipNode *target = update[0]->links[0].next;
+
+  // Merge the target's spans into its predecessors, shrink the ones above it
+  for (size_t lvl = 0; lvl < skip_list->level; lvl++) {
+    SkipLink *link = &update[lvl]->links[lvl];
+    if (link->next == target) {
+      link->width += target->links[lvl].width - 1;
+      link->next = target->links[lvl].next;
+    } else {
+      link->width -= 1;
+    }
+  }
+  if (target->links[0].next)
+    target->links[0].next->prev = update[0];
+
+  // Drop levels that no longer hold any node
+  while (skip_list->level > 1 &&
+         !skip_list->head->links[skip_list->level - 1].next)
+    skip_list->level -= 1;
+
+  void *data = target->data;
+  list_mem_free(skip_list->allocator, target);
+  skip_list->size -= 1;
+  return data;
+}
+
+/**
+ * @brief Find the node at a specific index in expected O(log n).
+ * @param skip_list Pointer to the skip list.
+ * @param index Index of the node to find.
+ * @return The node, or NULL if index is out of bounds.
+ */
+SkipNode *skip_list_find(const SkipList *skip_list, size_t index) {
+  if (!index_in_bounds(skip_list->size, index))
+    return NULL;
+
+  // Element `index` is index + 1 steps from the head
+  SkipNode *node = skip_list->head;
+  size_t remaining = index + 1;
+  for (size_t lvl = skip_list->level; lvl-- > 0;) {
+    while (node->links[lvl].next && node->links[lvl].width <= remaining) {
+      remaining -= node->links[lvl].width;
+      node = node->links[lvl].next;
+    }
+  }
+  return node;
+}
+
+void *skip_list_get(const SkipList *skip_list, size_t index) {
+  SkipNode *node = skip_list_find(skip_list, index);
+  return (node) ? node->data : NULL;
+}
+
+/*
+ * =========
+ * TREE LIST
+ * =========
+ */
+
+/**
+ * @brief Create a new tree list.
+ * @param storage Caller-provided storage for the list, or NULL to allocate.
+ * @param allocator Allocation options, or NULL for the defaults.
+ * @return Pointer to the newly created list, or NULL on failure.
+ */
+List *tree_list_create(List *storage, const ListAllocator *allocator) {
+  List *list = list_alloc_header(storage, LIST_TREE, allocator);
+  if (!list)
+    return NULL;
+
+  list->lists.tree_list.allocator = &list->allocator;
+  list->lists.tree_list.root = NULL;
+  list->lists.tree_list.pool = NULL;
+
+  return list;
+}
+
+size_t tree_node_size(const TreeNode *node) { return (node) ? node->size : 0; }
+
+size_t tree_node_height(const TreeNode *node) {
+  return (node) ? node->height : 0;
+}
+
+size_t tree_list_size(const TreeList *tree_list) {
+  return tree_node_size(tree_list->root);
+}
+
+/**
+ * @brief Release a node to the pool (or the heap without one).
+ * @param tree_list Pointer to the tree list.
+ * @param node Node to release.
+ */
+void tree_node_release(TreeList *tree_list, TreeNode *node) {
+  if (tree_list->pool)
+    node_pool_free(tree_list->pool, node);
+  else
+    list_mem_free(tree_list->allocator, node);
+}
+
+/**
+ * @brief Free every node of a subtree.
+ * @param tree_list Pointer to the tree list.
+ * @param node Root of the subtree.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void tree_node_destroy(TreeList *tree_list, TreeNode *node,
+                       FreeFunc free_func) {
+  if (!node)
+    return;
+  tree_node_destroy(tree_list, node->left, free_func);
+  tree_node_destroy(tree_list, node->right, free_func);
+  if (free_func)
+    free_func(node->data);
+  tree_node_release(tree_list, node);
+}
+
+/**
+ * @brief Remove every element, keeping the list (and its pool slabs) for reuse.
+ * @param list Pointer to the list to clear.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void tree_list_clear(List *list, FreeFunc free_func) {
+  TreeList *tree_list = &list->lists.tree_list;
+
+  // An unshared pool takes every node back at once, so only walk the tree
+  // when elements need freeing or nodes go back one by one
+  bool resetPool = list_owns_pool(list);
+  if (free_func || !resetPool)
+    tree_node_destroy(tree_list, tree_list->root, free_func);
+
+  tree_list->root = NULL;
+  if (resetPool)
+    node_pool_reset(list->pool);
+}
+
+/**
+ * @brief Destroy the tree list and free all associated memory.
+ * @param list Pointer to the list to destroy.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void tree_list_destroy(List *list, FreeFunc free_func) {
+  tree_list_clear(list, free_func);
+  node_pool_release(list->pool);
+  list_free_header(list);
+}
+
+/**
+ * @brief Recompute the cached size and height of a node from its children.
+ */
+void tree_node_update(TreeNode *node) {
+  size_t leftHeight = tree_node_height(node->left);
+  size_t rightHeight = tree_node_height(node->right);
+  node->size = tree_node_size(node->left) + tree_node_size(node->right) + 1;
+  node->height = ((leftHeight > rightHeight) ? leftHeight : rightHeight) + 1;
+}
+
+/**
+ * @brief Rotate a subtree right. The caller sets the new root's parent.
+ * @return New root of the subtree.
+ */
+TreeNode *tree_rotate_right(TreeNode *node) {
+  TreeNode *pivot = node->left;
+  node->left = pivot->right;
+  if (node->left)
+    node->left->parent = node;
+  pivot->right = node;
+  node->parent = pivot;
+  tree_node_update(node);
+  tree_node_update(pivot);
+  return pivot;
+}
+
+/**
+ * @brief Rotate a subtree left. The caller sets the new root's parent.
+ * @return New root of the subtree.
+ */
+TreeNode *tree_rotate_left(TreeNode *node) {
+  TreeNode *pivot = node->right;
+  node->right = pivot->left;
+  if (node->right)
+    node->right->parent = node;
+  pivot->left = node;
+  node->parent = pivot;
+  tree_node_update(node);
+  tree_node_update(pivot);
+  return pivot;
+}
+
+/**
+ * @brief Restore the AVL invariant at a node whose children are balanced.
+ * @return New root of the subtree (its parent is set by the caller).
+ */
+TreeNode *tree_rebalance(TreeNode *node) {
+  tree_node_update(node);
+  size_t leftHeight = tree_node_height(node->left);
+  size_t rightHeight = tree_node_height(node->right);
+
+  if (leftHeight > rightHeight + 1) {
+    // Left heavy (left-right case needs the child rotated first)
+    if (tree_node_height(node->left->left) <
+        tree_node_height(node->left->right)) {
+      node->left = tree_rotate_left(node->left);
+      node->left->parent = node;
+    }
+    return tree_rotate_right(node);
+  }
+  if (rightHeight > leftHeight + 1) {
+    // Right heavy (right-left case needs the child rotated first)
+    if (tree_node_height(node->right->right) <
+        tree_node_height(node->right->left)) {
+      node->right = tree_rotate_right(node->right);
+      node->right->parent = node;
+    }
+    return tree_rotate_left(node);
+  }
+  return node;
+}
+
+/**
+ * @brief Insert a node so it lands at in-order position `index`.
+ * @return New root of the subtree.
+ */
+TreeNode *tree_node_insert(TreeNode *node, size_t index, TreeNode *newNode) {
+  if (!node)
+    return newNode;
+
+  size_t leftSize = tree_node_size(node->left);
+  if (index <= leftSize) {
+    node->left = tree_node_insert(node->left, index, newNode);
+    node->left->parent = node;
+  } else {
+    node->right = tree_node_insert(node->right, index - leftSize - 1, newNode);
+    node->right->parent = node;
+  }
+  return tree_rebalance(node);
+}
+
+/**
+ * @brief Detach the left-most node of a subtree.
+ * @param node Root of the subtree.
+ * @param removed Out parameter for the detached node.
+ * @return New root of the subtree.
+ */
+TreeNode *tree_node_remove_min(TreeNode *node, TreeNode **removed) {
+  if (!node->left) {
+    *removed = node;
+    return node->right;
+  }
+  node->left = tree_node_remove_min(node->left, removed);
+  if (node->left)
+    node->left->parent = node;
+  return tree_rebalance(node);
+}
+
+/**
+ * @brief Detach the node at in-order position `index`.
+ * @param node Root of the subtree.
+ * @param index In-order position within the subtree.
+ * @param removed Out parameter for the detached node.
+ * @return New root of the subtree.
+ */
+TreeNode *tree_node_remove(TreeNode *node, size_t index, TreeNode **removed) {
+  size_t leftSize = tree_node_size(node->left);
+
+  if (index < leftSize) {
+    node->left = tree_node_remove(node->left, index, removed);
+    if (node->left)
+      node->left->parent = node;
+  } else if (index > leftSize) {
+    node->right = tree_node_remove(node->right, index - leftSize - 1, removed);
+    if (node->right)
+      node->right->parent = node;
+  } else {
+    *removed = node;
+    if (!node->left || !node->right)
+      return (node->left) ? node->left : node->right;
+
+    // Two children: the in-order successor takes this node's place
+    TreeNode *successor = NULL;
+    TreeNode *right = tree_node_remove_min(node->right, &successor);
+    successor->left = node->left;
+    successor->right = right;
+    successor->left->parent = successor;
+    if (successor->right)
+      successor->right->parent = successor;
+    node = successor;
+  }
+  return tree_rebalance(node);
+}
+
+/**
+ * @brief Insert an element at a specific index in O(log n).
+ * @param tree_list Pointer to the tree list.
+ * @param index Index at which to insert the element.
+ * @param data Pointer to the data to insert.
+ * @return true on success, false on failure (e.g., index out of bounds).
+ */
+bool tree_list_insert(TreeList *tree_list, size_t index, void *data) {
+  if (!data || index > tree_list_size(tree_list))
+    return false;
+
+  TreeNode *newNode = (tree_list->pool) ? node_pool_alloc(tree_list->pool)
+                                        : list_mem_alloc(tree_list->allocator,
+                                                         sizeof(TreeNode));
+  if (!newNode)
+    return false;
+  newNode->left = newNode->right = newNode->parent = NULL;
+  newNode->data = data;
+  newNode->size = newNode->height = 1;
+
+  tree_list->root = tree_node_insert(tree_list->root, index, newNode);
+  tree_list->root->parent = NULL;
+  return true;
+}
+
+bool tree_list_append(TreeList *tree_list, void *data) {
+  return tree_list_insert(tree_list, tree_list_size(tree_list), data);
+}
+
+/**
+ * @brief Remove an element at a specific index in O(log n).
+ * @param tree_list Pointer to the tree list.
+ * @param index Index of the element to remove.
+ * @return Pointer to the element, or NULL if index is out of bounds.
+ */
+void *tree_list_remove(TreeList *tree_list, size_t index) {
+  if (!index_in_bounds(tree_list_size(tree_list), index))
+    return NULL;
+
+  TreeNode *removed = NULL;
+  tree_list->root = tree_node_remove(tree_list->root, index, &removed);
+  if (tree_list->root)
+    tree_list->root->parent = NULL;
+
+  void *data = removed->data;
+  tree_node_release(tree_list, removed);
+  return data;
+}
+
+/**
+ * @brief Find the node at a specific index in O(log n).
+ * @param tree_list Pointer to the tree list.
+ * @param index Index of the node to find.
+ * @return The node, or NULL if index is out of bounds.
+ */
+TreeNode *tree_list_find(const TreeList *tree_list, size_t index) {
+  if (!index_in_bounds(tree_list_size(tree_list), index))
+    return NULL;
+
+  TreeNode *node = tree_list->root;
+  while (index != tree_node_size(node->left)) {
+    size_t leftSize = tree_node_size(node->left);
+    if (index < leftSize) {
+      node = node->left;
+    } else {
+      index -= leftSize + 1;
+      node = node->right;
+    }
+  }
+  return node;
+}
+
+void *tree_list_get(const TreeList *tree_list, size_t index) {
+  TreeNode *node = tree_list_find(tree_list, index);
+  return (node) ? node->data : NULL;
+}
+
+/**
+ * @brief Get the in-order successor of a node using parent links.
+ * @return The successor, or NULL for the last node.
+ */
+TreeNode *tree_node_next(TreeNode *node) {
+  if (node->right) {
+    node = node->right;
+    while (node->left)
+      node = node->left;
+    return node;
+  }
+  while (node->parent && node == node->parent->right)
+    node = node->parent;
+  return node->parent;
+}
+
+/**
+ * @brief Get the in-order predecessor of a node using parent links.
+ * @return The predecessor, or NULL for the first node.
+ */
+TreeNode *tree_node_prev(TreeNode *node) {
+  if (node->left) {
+    node = node->left;
+    while (node->right)
+      node = node->right;
+    return node;
+  }
+  while (node->parent && node == node->parent->left)
+    node = node->parent;
+  return node->parent;
+}
+
+/*
+ * ===============
+ * CONCURRENT LIST
+ * ===============
+ */
+
+/**
+ * @brief Create a new concurrent list.
+ * @param storage Caller-provided storage for the list, or NULL to allocate.
+ * @param allocator Allocation options, or NULL for the defaults.
+ * @return Pointer to the newly created list, or NULL on failure.
+ */
+List *concurrent_list_create(List *storage, const ListAllocator *allocator) {
+  List *list = list_alloc_header(storage, LIST_CONCURRENT, allocator);
+  if (!list)
+    return NULL;
+
+  ConcurrentList *concurrent_list =
+      list_mem_alloc(&list->allocator, sizeof(ConcurrentList));
+  if (!concurrent_list ||
+      pthread_rwlock_init(&concurrent_list->lock, NULL) != 0) {
+    list_mem_free(&list->allocator, concurrent_list);
+    list_free_header(list);
+    return NULL;
+  }
+  sentinel_list_init(&concurrent_list->list);
+
+  list->lists.concurrent_list = concurrent_list;
+  return list;
+}
+
+/**
+ * @brief Remove every element, keeping the list for reuse.
+ * @param list Pointer to the list to clear.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void concurrent_list_clear(List *list, FreeFunc free_func) {
+  ConcurrentList *concurrent_list = list->lists.concurrent_list;
+  pthread_rwlock_wrlock(&concurrent_list->lock);
+  sentinel_list_release(&concurrent_list->list, free_func);
+  pthread_rwlock_unlock(&concurrent_list->lock);
+}
+
+/**
+ * @brief Destroy the concurrent list and free all associated memory. No other
+ * thread may still be using the list.
+ * @param list Pointer to the list to destroy.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void concurrent_list_destroy(List *list, FreeFunc free_func) {
+  ConcurrentList *concurrent_list = list->lists.concurrent_list;
+  sentinel_list_release(&concurrent_list->list, free_func);
+  pthread_rwlock_destroy(&concurrent_list->lock);
+  list_mem_free(&list->allocator, concurrent_list);
+  list_free_header(list);
+}
+
+/**
+ * @brief Insert a node at a specific index under the write lock.
+ * @param concurrent_list Pointer to the concurrent list.
+ * @param index Index at which to insert (the size appends).
+ * @param newNode Pointer to the Node struct to insert.
+ * @return true on success, false if index is out of bounds.
+ */
+bool concurrent_list_insert(ConcurrentList *concurrent_list, size_t index,
+                            Node *newNode) {
+  pthread_rwlock_wrlock(&concurrent_list->lock);
+  bool inserted = sentinel_list_insert(&concurrent_list->list, index, newNode);
+  pthread_rwlock_unlock(&concurrent_list->lock);
+  return inserted;
+}
+
+/**
+ * @brief Append a node under the write lock.
+ * @param concurrent_list Pointer to the concurrent list.
+ * @param newTail Pointer to the Node struct to append.
+ * @return true on success, false on failure.
+ */
+bool concurrent_list_append(ConcurrentList *concurrent_list, Node *newTail) {
+  pthread_rwlock_wrlock(&concurrent_list->lock);
+  bool appended = sentinel_list_append(&concurrent_list->list, newTail);
+  pthread_rwlock_unlock(&concurrent_list->lock);
+  return appended;
+}
+
+/**
+ * @brief Insert a batch of nodes at a specific index as one locked edit.
+ * @param concurrent_list Pointer to the concurrent list.
+ * @param index Index at which to insert the first node.
+ * @param nodes Array of Node pointers, in order.
+ * @param count Number of nodes.
+ * @return true on success, false if index is out of bounds.
+ */
+bool concurrent_list_insert_many(ConcurrentList *concurrent_list, size_t index,
+                                 void **nodes, size_t count) {
+  pthread_rwlock_wrlock(&concurrent_list->lock);
+  bool inserted =
+      sentinel_list_insert_many(&concurrent_list->list, index, nodes, count);
+  pthread_rwlock_unlock(&concurrent_list->lock);
+  return inserted;
+}
+
+/**
+ * @brief Move every node of `src` into `dst` at a specific index, holding
+ * both write locks (taken in address order so opposite splices can't
+ * deadlock).
+ * @param dst Pointer to the destination list.
+ * @param index Index in `dst` at which the nodes of `src` start.
+ * @param src Pointer to the source list (left empty).
+ * @return true on success, false if index is out of bounds.
+ */
+bool concurrent_list_splice(ConcurrentList *dst, size_t index,
+                            ConcurrentList *src) {
+  ConcurrentList *first = (dst < src) ? dst : src;
+  ConcurrentList *second = (dst < src) ? src : dst;
+  pthread_rwlock_wrlock(&first->lock);
+  pthread_rwlock_wrlock(&second->lock);
+  bool spliced = sentinel_list_splice(&dst->list, index, &src->list);
+  pthread_rwlock_unlock(&second->lock);
+  pthread_rwlock_unlock(&first->lock);
+  return spliced;
+}
+
+/**
+ * @brief Move the nodes from `index` on into an empty (not yet shared) list.
+ * @param concurrent_list Pointer to the list to split.
+ * @param index Index of the first node to move.
+ * @param suffix Pointer to the empty list receiving the nodes.
+ * @return true on success, false if index is out of bounds.
+ */
+bool concurrent_list_split_at(ConcurrentList *concurrent_list, size_t index,
+                              ConcurrentList *suffix) {
+  pthread_rwlock_wrlock(&concurrent_list->lock);
+  bool split =
+      sentinel_list_split_at(&concurrent_list->list, index, &suffix->list);
+  pthread_rwlock_unlock(&concurrent_list->lock);
+  return split;
+}
+
+/**
+ * @brief Remove the node at a specific index under the write lock.
+ * @param concurrent_list Pointer to the concurrent list.
+ * @param index Index of the node to remove.
+ * @return Pointer to the removed node, or NULL if index is out of bounds.
+ */
+void *concurrent_list_remove(ConcurrentList *concurrent_list, size_t index) {
+  pthread_rwlock_wrlock(&concurrent_list->lock);
+  void *removed = sentinel_list_remove(&concurrent_list->list, index);
+  pthread_rwlock_unlock(&concurrent_list->lock);
+  return removed;
+}
+
+bool concurrent_list_push_front(ConcurrentList *concurrent_list,
+                                Node *newHead) {
+  pthread_rwlock_wrlock(&concurrent_list->lock);
+  bool pushed = sentinel_list_push_front(&concurrent_list->list, newHead);
+  pthread_rwlock_unlock(&concurrent_list->lock);
+  return pushed;
+}
+
+/**
+ * @brief Unlink the first or last node under the write lock.
+ * @param concurrent_list Pointer to the concurrent list.
+ * @param back true to pop the last node, false for the first.
+ * @return Pointer to the node, or NULL if the list is empty.
+ */
+void *concurrent_list_pop(ConcurrentList *concurrent_list, bool back) {
+  pthread_rwlock_wrlock(&concurrent_list->lock);
+  void *removed = (back) ? sentinel_list_pop_back(&concurrent_list->list)
+                         : sentinel_list_pop_front(&concurrent_list->list);
+  pthread_rwlock_unlock(&concurrent_list->lock);
+  return removed;
+}
+
+/**
+ * @brief Get the first or last node under a shared read lock.
+ * @param concurrent_list Pointer to the concurrent list.
+ * @param back true for the last node, false for the first.
+ * @return Pointer to the node, or NULL if the list is empty.
+ */
+void *concurrent_list_peek(ConcurrentList *concurrent_list, bool back) {
+  pthread_rwlock_rdlock(&concurrent_list->lock);
+  void *node = (back) ? sentinel_list_peek_back(&concurrent_list->list)
+                      : sentinel_list_peek_front(&concurrent_list->list);
+  pthread_rwlock_unlock(&concurrent_list->lock);
+  return node;
+}
+
+/**
+ * @brief Get the node at a specific index under a shared read lock. The walk
+ * may start from the finger but never moves it, so readers don't write.
+ * @param concurrent_list Pointer to the concurrent list.
+ * @param index Index of the node to retrieve.
+ * @return Pointer to the node, or NULL if index is out of bounds.
+ */
+void *concurrent_list_get(ConcurrentList *concurrent_list, size_t index) {
+  pthread_rwlock_rdlock(&concurrent_list->lock);
+  void *node = NULL;
+  if (index_in_bounds(sentinel_list_size(&concurrent_list->list), index))
+    node = sentinel_list_walk(&concurrent_list->list, index);
+  pthread_rwlock_unlock(&concurrent_list->lock);
+  return node;
+}
+
+/**
+ * @brief Get the size of the list under a shared read lock.
+ * @param concurrent_list Pointer to the concurrent list.
+ * @return The number of elements in the list.
+ */
+size_t concurrent_list_size(ConcurrentList *concurrent_list) {
+  pthread_rwlock_rdlock(&concurrent_list->lock);
+  size_t size = sentinel_list_size(&concurrent_list->list);
+  pthread_rwlock_unlock(&concurrent_list->lock);
+  return size;
+}
+
+/**
+ * @brief Get the sentinel list behind a sentinel, concurrent, sharded or
+ * bounded list (for a sharded list, the gathered one).
+ * @param list Pointer to a LIST_LINKED_SENTINEL, LIST_CONCURRENT,
+ * LIST_SHARDED or LIST_BOUNDED list.
+ * @return Pointer to the sentinel list.
+ */
+SentinelLinkedList *list_sentinel_list(List *list) {
+  if (list->type == LIST_SHARDED)
+    return &list->lists.sharded_list->gathered;
+  if (list->type == LIST_BOUNDED)
+    return &list->lists.bounded_queue->list;
+  return (list->type == LIST_CONCURRENT) ? &list->lists.concurrent_list->list
+                                         : &list->lists.sentinel_list;
+}
+
+/*
+ * ==========
+ * MPSC QUEUE
+ * ==========
+ */
+
+/**
+ * @brief Create a new MPSC queue list.
+ * @param storage Caller-provided storage for the list, or NULL to allocate.
+ * @param allocator Allocation options, or NULL for the defaults.
+ * @return Pointer to the newly created list, or NULL on failure.
+ */
+List *mpsc_queue_create(List *storage, const ListAllocator *allocator) {
+  List *list = list_alloc_header(storage, LIST_MPSC, allocator);
+  if (!list)
+    return NULL;
+
+  MpscQueue *queue = list_mem_alloc(&list->allocator, sizeof(MpscQueue));
+  if (!queue) {
+    list_free_header(list);
+    return NULL;
+  }
+  queue->stub.type = SENTINEL;
+  queue->stub.next = queue->stub.prev = NULL;
+  queue->head = queue->tail = &queue->stub;
+  queue->pushed = queue->popped = 0;
+
+  list->lists.mpsc_queue = queue;
+  return list;
+}
+
+/**
+ * @brief Append a chain of nodes already linked through next (any thread).
+ * Takes one atomic exchange however long the chain is.
+ * @param queue Pointer to the queue.
+ * @param first First node of the chain.
+ * @param last Last node of the chain.
+ */
+void mpsc_queue_push_chain(MpscQueue *queue, Node *first, Node *last) {
+  __atomic_store_n(&last->next, NULL, __ATOMIC_RELAXED);
+  Node *prev = __atomic_exchange_n(&queue->tail, last, __ATOMIC_ACQ_REL);
+  // The consumer can't see past `prev` until this store lands
+  __atomic_store_n(&prev->next, first, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Append a node (any thread).
+ * @param queue Pointer to the queue.
+ * @param node Pointer to the Node struct to append.
+ * @return true (appending can't fail).
+ */
+bool mpsc_queue_push(MpscQueue *queue, Node *node) {
+  node->prev = NULL; // only next links are maintained
+  __atomic_fetch_add(&queue->pushed, 1, __ATOMIC_RELAXED);
+  mpsc_queue_push_chain(queue, node, node);
+  return true;
+}
+
+/**
+ * @brief Append a batch of nodes with a single exchange (any thread).
+ * @param queue Pointer to the queue.
+ * @param nodes Array of Node pointers, in order.
+ * @param count Number of nodes.
+ * @return true (appending can't fail).
+ */
+bool mpsc_queue_push_many(MpscQueue *queue, void **nodes, size_t count) {
+  if (count == 0)
+    return true;
+
+  // Link the batch privately first, then publish it at once
+  for (size_t i = 0; i < count; i++) {
+    Node *node = nodes[i];
+    node->prev = NULL;
+    node->next = (i + 1 < count) ? nodes[i + 1] : NULL;
+  }
+  __atomic_fetch_add(&queue->pushed, count, __ATOMIC_RELAXED);
+  mpsc_queue_push_chain(queue, nodes[0], nodes[count - 1]);
+  return true;
+}
+
+/**
+ * @brief Pop the oldest node (consumer thread only). Never waits: if the only
+ * remaining node's producer hasn't linked it yet, it reports empty for now.
+ * @param queue Pointer to the queue.
+ * @return Pointer to the node, or NULL if nothing is ready.
+ */
+Node *mpsc_queue_pop(MpscQueue *queue) {
+  Node *head = queue->head;
+  Node *next = __atomic_load_n(&head->next, __ATOMIC_ACQUIRE);
+
+  // Step over the stub
+  if (head == &queue->stub) {
+    if (!next)
+      return NULL;
+    queue->head = head = next;
+    next = __atomic_load_n(&head->next, __ATOMIC_ACQUIRE);
+  }
+
+  if (!next) {
+    // `head` is the last node: re-queue the stub behind it so it can go
+    if (__atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE) != head)
+      return NULL; // a producer swapped in but hasn't linked yet
+    mpsc_queue_push_chain(queue, &queue->stub, &queue->stub);
+    next = __atomic_load_n(&head->next, __ATOMIC_ACQUIRE);
+    if (!next)
+      return NULL; // GCOVR_EXCL_LINE
+  }
+
+  queue->head = next;
+  // Release: a thread that sees this count also sees the pushes behind it
+  __atomic_store_n(&queue->popped, queue->popped + 1, __ATOMIC_RELEASE);
+  head->next = NULL; // avoids dangling pointer
+  return head;
+}
+
+/**
+ * @brief Get the first linked node after `node`, skipping the stub
+ * (consumer thread only).
+ * @param queue Pointer to the queue.
+ * @param node Node to start after, or NULL to start from the head.
+ * @return The next node, or NULL at the end of what is linked so far.
+ */
+Node *mpsc_queue_next(MpscQueue *queue, Node *node) {
+  node = (node) ? __atomic_load_n(&node->next, __ATOMIC_ACQUIRE) : queue->head;
+  if (node == &queue->stub)
+    node = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE);
+  return node;
+}
+
+/**
+ * @brief Get the node at a specific index (consumer thread only).
+ * @param queue Pointer to the queue.
+ * @param index Index of the node to retrieve.
+ * @return Pointer to the node, or NULL if it isn't linked (yet).
+ */
+void *mpsc_queue_get(MpscQueue *queue, size_t index) {
+  Node *node = mpsc_queue_next(queue, NULL);
+  while (node && index-- > 0)
+    node = mpsc_queue_next(queue, node);
+  return node;
+}
+
+/**
+ * @brief Get the number of appended nodes not popped yet (any thread).
+ * @param queue Pointer to the queue.
+ * @return The number of elements, including appends still being linked.
+ */
+size_t mpsc_queue_size(const MpscQueue *queue) {
+  // Read popped first: pushed only grows, so the difference never underflows
+  size_t popped = __atomic_load_n(&queue->popped, __ATOMIC_ACQUIRE);
+  return __atomic_load_n(&queue->pushed, __ATOMIC_ACQUIRE) - popped;
+}
+
+/**
+ * @brief Get the most recently appended node (consumer thread only). It may
+ * not be linked behind the others yet.
+ * @param queue Pointer to the queue.
+ * @return Pointer to the node, or NULL if the queue is empty.
+ */
+void *mpsc_queue_peek_back(MpscQueue *queue) {
+  Node *tail = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+  // A stub at the tail means every appended node has been popped
+  return (tail != &queue->stub && mpsc_queue_size(queue) > 0) ? tail : NULL;
+}
+
+/**
+ * @brief Pop every linked node (consumer thread only).
+ * @param list Pointer to the list to clear.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void mpsc_queue_clear(List *list, FreeFunc free_func) {
+  Node *node;
+  while ((node = mpsc_queue_pop(list->lists.mpsc_queue))) {
+    if (free_func)
+      free_func(node);
+  }
+}
+
+/**
+ * @brief Destroy the MPSC queue and free all associated memory. No producer
+ * may still be appending.
+ * @param list Pointer to the list to destroy.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void mpsc_queue_destroy(List *list, FreeFunc free_func) {
+  mpsc_queue_clear(list, free_func);
+  list_mem_free(&list->allocator, list->lists.mpsc_queue);
+  list_free_header(list);
+}
+
+/*
+ * ===============
+ * LOCK-FREE DEQUE
+ * ===============
+ */
+
+/**
+ * @brief Allocate an empty deque buffer.
+ * @param allocator Allocator the buffer comes from.
+ * @param capacity Number of slots (a power of two).
+ * @return Pointer to the buffer, or NULL on failure.
+ */
+DequeArray *lockfree_deque_array_create(const ListAllocator *allocator,
+                                        size_t capacity) {
+  DequeArray *array =
+      list_mem_alloc(allocator, sizeof(DequeArray) + capacity * sizeof(void *));
+  if (!array)
+    return NULL;
+  array->capacity = capacity;
+  array->retired = NULL;
+  return array;
+}
+
+/**
+ * @brief Create a new lock-free deque list.
+ * @param storage Caller-provided storage for the list, or NULL to allocate.
+ * @param allocator Allocation options, or NULL for the defaults.
+ * @return Pointer to the newly created list, or NULL on failure.
+ */
+List *lockfree_deque_create(List *storage, const ListAllocator *allocator) {
+  List *list = list_alloc_header(storage, LIST_DEQUE_LOCKFREE, allocator);
+  if (!list)
+    return NULL;
+
+  LockFreeDeque *deque =
+      list_mem_alloc(&list->allocator, sizeof(LockFreeDeque));
+  DequeArray *array = lockfree_deque_array_create(
+      &list->allocator, LOCKFREE_DEQUE_INITIAL_CAPACITY);
+  if (!deque || !array) {
+    list_mem_free(&list->allocator, array);
+    list_mem_free(&list->allocator, deque);
+    list_free_header(list);
+    return NULL;
+  }
+  deque->top = deque->bottom = 0;
+  deque->array = array;
+  deque->allocator = &list->allocator;
+
+  list->lists.lockfree_deque = deque;
+  return list;
+}
+
+/**
+ * @brief Move the elements into a buffer twice as large (owner only).
+ * @param deque Pointer to the deque.
+ * @param array The current (full) buffer.
+ * @param top Index of the oldest element.
+ * @param bottom Index one past the newest element.
+ * @return Pointer to the new buffer, or NULL on failure.
+ */
+DequeArray *lockfree_deque_grow(LockFreeDeque *deque, DequeArray *array,
+                                int64_t top, int64_t bottom) {
+  DequeArray *bigger =
+      lockfree_deque_array_create(deque->allocator, array->capacity * 2);
+  if (!bigger)
+    return NULL;
+
+  // Indices are absolute, so each element keeps its index in the new buffer
+  for (int64_t i = top; i < bottom; i++) {
+    void *data = __atomic_load_n(
+        &array->items[(size_t)i & (array->capacity - 1)], __ATOMIC_RELAXED);
+    bigger->items[(size_t)i & (bigger->capacity - 1)] = data;
+  }
+  bigger->retired = array;
+  __atomic_store_n(&deque->array, bigger, __ATOMIC_RELEASE);
+  return bigger;
+}
+
+/**
+ * @brief Push an element at the back (owner only).
+ * @param deque Pointer to the deque.
+ * @param data Pointer to the data to push.
+ * @return true on success, false on failure.
+ */
+bool lockfree_deque_push_back(LockFreeDeque *deque, void *data) {
+  if (!data)
+    return false;
+
+  int64_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED);
+  int64_t top = __atomic_load_n(&deque->top, __ATOMIC_ACQUIRE);
+  DequeArray *array = __atomic_load_n(&deque->array, __ATOMIC_RELAXED);
+  if ((size_t)(bottom - top) >= array->capacity) {
+    array = lockfree_deque_grow(deque, array, top, bottom);
+    if (!array)
+      return false;
+  }
+
+  __atomic_store_n(&array->items[(size_t)bottom & (array->capacity - 1)],
+                   data, __ATOMIC_RELAXED);
+  // Publish the element before the new bottom that makes it stealable
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  __atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+  return true;
+}
+
+/**
+ * @brief Pop the newest element from the back (owner only).
+ * @param deque Pointer to the deque.
+ * @return Pointer to the data, or NULL if the deque is empty.
+ */
+void *lockfree_deque_pop_back(LockFreeDeque *deque) {
+  int64_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED) - 1;
+  DequeArray *array = __atomic_load_n(&deque->array, __ATOMIC_RELAXED);
+  // Claim the slot before looking at top, so thieves see the claim
+  __atomic_store_n(&deque->bottom, bottom, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  int64_t top = __atomic_load_n(&deque->top, __ATOMIC_RELAXED);
+
+  void *data = NULL;
+  if (top <= bottom) {
+    data = __atomic_load_n(
+        &array->items[(size_t)bottom & (array->capacity - 1)],
+        __ATOMIC_RELAXED);
+    if (top == bottom) {
+      // Last element: race the thieves for it
+      if (!__atomic_compare_exchange_n(&deque->top, &top, top + 1, false,
+                                       __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+        data = NULL;
+      __atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+    }
+  } else {
+    // Already empty: undo the claim
+    __atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+  }
+  return data;
+}
+
+/**
+ * @brief Steal the oldest element from the front (any thread). Retries when
+ * it loses a race, so NULL means the deque was seen empty.
+ * @param deque Pointer to the deque.
+ * @return Pointer to the data, or NULL if the deque is empty.
+ */
+void *lockfree_deque_steal(LockFreeDeque *deque) {
+  for (;;) {
+    int64_t top = __atomic_load_n(&deque->top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int64_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_ACQUIRE);
+    if (top >= bottom)
+      return NULL;
+
+    DequeArray *array = __atomic_load_n(&deque->array, __ATOMIC_ACQUIRE);
+    void *data = __atomic_load_n(
+        &array->items[(size_t)top & (array->capacity - 1)], __ATOMIC_RELAXED);
+    if (__atomic_compare_exchange_n(&deque->top, &top, top + 1, false,
+                                    __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+      return data;
+    // Lost to another thief or the owner: look again
+  }
+}
+
+/**
+ * @brief Get the number of elements (a snapshot while threads are active).
+ * @param deque Pointer to the deque.
+ * @return The number of elements in the deque.
+ */
+size_t lockfree_deque_size(const LockFreeDeque *deque) {
+  int64_t top = __atomic_load_n(&deque->top, __ATOMIC_ACQUIRE);
+  int64_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_ACQUIRE);
+  // The owner's pop briefly moves bottom below top
+  return (bottom > top) ? (size_t)(bottom - top) : 0;
+}
+
+/**
+ * @brief Get the element at a specific index from the front (owner only).
+ * @param deque Pointer to the deque.
+ * @param index Index of the element to retrieve.
+ * @return Pointer to the data, or NULL if index is out of bounds.
+ */
+void *lockfree_deque_get(LockFreeDeque *deque, size_t index) {
+  int64_t top = __atomic_load_n(&deque->top, __ATOMIC_ACQUIRE);
+  int64_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED);
+  if (top >= bottom || index >= (size_t)(bottom - top))
+    return NULL;
+  DequeArray *array = __atomic_load_n(&deque->array, __ATOMIC_RELAXED);
+  size_t slot = ((size_t)top + index) & (array->capacity - 1);
+  return __atomic_load_n(&array->items[slot], __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Pop every element (owner only).
+ * @param list Pointer to the list to clear.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void lockfree_deque_clear(List *list, FreeFunc free_func) {
+  void *data;
+  while ((data = lockfree_deque_pop_back(list->lists.lockfree_deque))) {
+    if (free_func)
+      free_func(data);
+  }
+}
+
+/**
+ * @brief Destroy the lock-free deque, its buffer and every buffer it
+ * replaced. No thief may still be using the deque.
+ * @param list Pointer to the list to destroy.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void lockfree_deque_destroy(List *list, FreeFunc free_func) {
+  lockfree_deque_clear(list, free_func);
+
+  LockFreeDeque *deque = list->lists.lockfree_deque;
+  DequeArray *array = deque->array;
+  while (array) {
+    DequeArray *retired = array->retired;
+    list_mem_free(&list->allocator, array);
+    array = retired;
+  }
+  list_mem_free(&list->allocator, deque);
+  list_free_header(list);
+}
+
+/*
+ * ========
+ * RCU LIST
+ * ========
+ */
+
+#ifdef TEST
+void (*rcu_list_read_stall)(void) = NULL;
+#endif
+
+/**
+ * @brief Create a new RCU list.
+ * @param storage Caller-provided storage for the list, or NULL to allocate.
+ * @param allocator Allocation options, or NULL for the defaults.
+ * @return Pointer to the newly created list, or NULL on failure.
+ */
+List *rcu_list_create(List *storage, const ListAllocator *allocator) {
+  List *list = list_alloc_header(storage, LIST_RCU, allocator);
+  if (!list)
+    return NULL;
+
+  RcuList *rcu_list = list_mem_aligned_alloc(
+      &list->allocator, LOCKFREE_CACHE_LINE, sizeof(RcuList));
+  if (!rcu_list || pthread_mutex_init(&rcu_list->lock, NULL) != 0) {
+    list_mem_free(&list->allocator, rcu_list);
+    list_free_header(list);
+    return NULL;
+  }
+  memset(rcu_list->readers, 0, sizeof(rcu_list->readers));
+  rcu_list->phase = 0;
+  sentinel_list_init(&rcu_list->list);
+
+  list->lists.rcu_list = rcu_list;
+  return list;
+}
+
+/**
+ * @brief Enter a read-side section (any thread, may nest).
+ * @param rcu_list Pointer to the RCU list.
+ * @return Token to pass to rcu_list_read_unlock.
+ */
+size_t rcu_list_read_lock(RcuList *rcu_list) {
+  // The top 6 bits of the hash pick one of the 64 slots
+  size_t slot = (size_t)(list_thread_hash() >> 58);
+  size_t phase = __atomic_load_n(&rcu_list->phase, __ATOMIC_RELAXED) & 1;
+#ifdef TEST
+  if (rcu_list_read_stall)
+    rcu_list_read_stall();
+#endif
+
+  // Full barrier: none of the section's reads can move above the count
+  __atomic_fetch_add(&rcu_list->readers[slot].active[phase], 1,
+                     __ATOMIC_SEQ_CST);
+  return slot * 2 + phase;
+}
+
+void rcu_list_read_unlock(RcuList *rcu_list, size_t token) {
+  __atomic_fetch_sub(&rcu_list->readers[token / 2].active[token % 2], 1,
+                     __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Wait for a grace period (writer lock held): every read-side section
+ * open when this was called has ended. Must not be called from inside a
+ * read-side section.
+ * @param rcu_list Pointer to the RCU list.
+ */
+void rcu_list_synchronize(RcuList *rcu_list) {
+  // Sections starting after a flip count in the other phase, and they can't
+  // reach anything unlinked before it. A reader that read the phase before
+  // the first flip may still count itself in the old phase after it has
+  // drained, so both phases are flipped and drained (as userspace RCU does).
+  for (int flip = 0; flip < 2; flip++) {
+    size_t phase = rcu_list->phase & 1;
+    __atomic_store_n(&rcu_list->phase, rcu_list->phase + 1, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    for (size_t slot = 0; slot < RCU_READER_SLOTS; slot++) {
+      while (__atomic_load_n(&rcu_list->readers[slot].active[phase],
+                             __ATOMIC_ACQUIRE) != 0)
+        sched_yield();
+    }
+  }
+}
+
+/**
+ * @brief Get the node after another one (read side).
+ * @param node Pointer to the current node (or the sentinel).
+ * @return The next node, the sentinel at the end.
+ */
+Node *rcu_list_next(const Node *node) {
+  return __atomic_load_n(&node->next, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Link a chain of nodes in before another node (writer lock held),
+ * making the whole chain visible to readers with a single store.
+ * @param sentinel_list Pointer to the sentinel list.
+ * @param nextNode Node that will follow the chain (sentinel to append).
+ * @param index Index the first node ends up at.
+ * @param nodes Array of Node pointers, in order.
+ * @param count Number of nodes.
+ */
+void rcu_list_link_before(SentinelLinkedList *sentinel_list, Node *nextNode,
+                          size_t index, void **nodes, size_t count) {
+  if (count == 0)
+    return;
+
+  // Link the chain privately first: no reader can reach it yet
+  Node *oldPrev = nextNode->prev;
+  Node *prevNode = oldPrev;
+  for (size_t i = 0; i < count; i++) {
+    Node *newNode = nodes[i];
+    newNode->prev = prevNode;
+    if (prevNode != oldPrev)
+      prevNode->next = newNode;
+    prevNode = newNode;
+  }
+  prevNode->next = nextNode;
+  nextNode->prev = prevNode;
+
+  // Publish: a reader that sees the first node sees the chain linked
+  __atomic_store_n(&oldPrev->next, (Node *)nodes[0], __ATOMIC_RELEASE);
+
+  if (nextNode == sentinel_list->head)
+    __atomic_store_n(&sentinel_list->tail, prevNode, __ATOMIC_RELEASE);
+  __atomic_store_n(&sentinel_list->size, sentinel_list->size + count,
+                   __ATOMIC_RELAXED);
+  sentinel_list->finger = nodes[0];
+  sentinel_list->finger_index = index;
+}
+
+/**
+ * @brief Unlink a node (writer lock held). Its own next pointer is left alone
+ * so readers standing on it can still move on.
+ * @param sentinel_list Pointer to the sentinel list.
+ * @param node Pointer to the (non-sentinel) Node struct to unlink.
+ * @param index Index of the node being unlinked.
+ */
+void rcu_list_unlink(SentinelLinkedList *sentinel_list, Node *node,
+                     size_t index) {
+  Node *prevNode = node->prev;
+  Node *nextNode = node->next;
+  __atomic_store_n(&prevNode->next, nextNode, __ATOMIC_RELEASE);
+  nextNode->prev = prevNode;
+
+  if (node == sentinel_list->tail)
+    __atomic_store_n(&sentinel_list->tail, prevNode, __ATOMIC_RELEASE);
+  __atomic_store_n(&sentinel_list->size, sentinel_list->size - 1,
+                   __ATOMIC_RELAXED);
+  sentinel_list->finger = (nextNode != sentinel_list->head) ? nextNode : NULL;
+  sentinel_list->finger_index = index;
+}
+
+/**
+ * @brief Remove every element, keeping the list for reuse. The whole ring is
+ * detached at once; free_func only runs after a grace period.
+ * @param list Pointer to the list to clear.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void rcu_list_clear(List *list, FreeFunc free_func) {
+  RcuList *rcu_list = list->lists.rcu_list;
+  SentinelLinkedList *sentinel_list = &rcu_list->list;
+  Node *sentinelNode = sentinel_list->head;
+
+  pthread_mutex_lock(&rcu_list->lock);
+  Node *currNode = sentinelNode->next;
+  __atomic_store_n(&sentinelNode->next, sentinelNode, __ATOMIC_RELEASE);
+  __atomic_store_n(&sentinel_list->tail, sentinelNode, __ATOMIC_RELEASE);
+  __atomic_store_n(&sentinel_list->size, 0, __ATOMIC_RELAXED);
+  sentinelNode->prev = sentinelNode;
+  sentinel_list->finger = NULL;
+  sentinel_list->finger_index = 0;
+  if (currNode != sentinelNode)
+    rcu_list_synchronize(rcu_list);
+  pthread_mutex_unlock(&rcu_list->lock);
+
+  // The detached chain still ends at the sentinel
+  while (currNode != sentinelNode) {
+    Node *nextNode = currNode->next;
+    if (free_func)
+      free_func(currNode);
+    currNode = nextNode;
+  }
+}
+
+/**
+ * @brief Destroy the RCU list and free all associated memory. No other thread
+ * may still be using the list.
+ * @param list Pointer to the list to destroy.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void rcu_list_destroy(List *list, FreeFunc free_func) {
+  RcuList *rcu_list = list->lists.rcu_list;
+  rcu_list_clear(list, free_func);
+  pthread_mutex_destroy(&rcu_list->lock);
+  list_mem_free(&list->allocator, rcu_list);
+  list_free_header(list);
+}
+
+/**
+ * @brief Insert a batch of nodes at a specific index, published as one edit.
+ * @param rcu_list Pointer to the RCU list.
+ * @param index Index at which to insert the first node (SIZE_MAX appends).
+ * @param nodes Array of Node pointers, in order.
+ * @param count Number of nodes.
+ * @return true on success, false if index is out of bounds.
+ */
+bool rcu_list_insert_many(RcuList *rcu_list, size_t index, void **nodes,
+                          size_t count) {
+  SentinelLinkedList *sentinel_list = &rcu_list->list;
+  pthread_mutex_lock(&rcu_list->lock);
+
+  // Resolve the end under the lock, not from a size that may change
+  if (index == SIZE_MAX)
+    index = sentinel_list->size;
+  Node *nextNode = sentinel_list_find(sentinel_list, index);
+  if (nextNode)
+    rcu_list_link_before(sentinel_list, nextNode, index, nodes, count);
+
+  pthread_mutex_unlock(&rcu_list->lock);
+  return nextNode != NULL;
+}
+
+bool rcu_list_insert(RcuList *rcu_list, size_t index, Node *newNode) {
+  void *nodes[] = {newNode};
+  return rcu_list_insert_many(rcu_list, index, nodes, 1);
+}
+
+bool rcu_list_append(RcuList *rcu_list, Node *newTail) {
+  return rcu_list_insert(rcu_list, SIZE_MAX, newTail);
+}
+
+/**
+ * @brief Remove the node at a specific index. Returns only after a grace
+ * period, so the caller may free or reuse the node right away.
+ * @param rcu_list Pointer to the RCU list.
+ * @param index Index of the node to remove (SIZE_MAX for the last one).
+ * @return Pointer to the removed node, or NULL if index is out of bounds.
+ */
+void *rcu_list_remove(RcuList *rcu_list, size_t index) {
+  SentinelLinkedList *sentinel_list = &rcu_list->list;
+  pthread_mutex_lock(&rcu_list->lock);
+
+  if (index == SIZE_MAX && sentinel_list->size > 0)
+    index = sentinel_list->size - 1;
+  Node *node = NULL;
+  if (index_in_bounds(sentinel_list->size, index)) {
+    node = sentinel_list_find(sentinel_list, index);
+    rcu_list_unlink(sentinel_list, node, index);
+    rcu_list_synchronize(rcu_list);
+  }
+
+  pthread_mutex_unlock(&rcu_list->lock);
+  if (node)
+    node->next = node->prev = NULL; // avoids dangling pointer
+  return node;
+}
+
+/**
+ * @brief Get the node at a specific index (read side, wait-free). The walk
+ * runs in its own read-side section; the node stays valid for as long as
+ * the caller holds one.
+ * @param rcu_list Pointer to the RCU list.
+ * @param index Index of the node to retrieve.
+ * @return Pointer to the node, or NULL if index is out of bounds.
+ */
+void *rcu_list_get(RcuList *rcu_list, size_t index) {
+  size_t token = rcu_list_read_lock(rcu_list);
+  Node *sentinelNode = rcu_list->list.head;
+  Node *node = rcu_list_next(sentinelNode);
+  while (node != sentinelNode && index-- > 0)
+    node = rcu_list_next(node);
+  rcu_list_read_unlock(rcu_list, token);
+  return (node != sentinelNode) ? node : NULL;
+}
+
+/**
+ * @brief Get the first or last node (read side, wait-free).
+ * @param rcu_list Pointer to the RCU list.
+ * @param back true for the last node, false for the first.
+ * @return Pointer to the node, or NULL if the list is empty.
+ */
+void *rcu_list_peek(RcuList *rcu_list, bool back) {
+  Node *sentinelNode = rcu_list->list.head;
+  Node *node = (back) ? __atomic_load_n(&rcu_list->list.tail, __ATOMIC_ACQUIRE)
+                      : rcu_list_next(sentinelNode);
+  return (node != sentinelNode) ? node : NULL;
+}
+
+size_t rcu_list_size(const RcuList *rcu_list) {
+  return __atomic_load_n(&rcu_list->list.size, __ATOMIC_RELAXED);
+}
+
+/*
+ * ============
+ * SHARDED LIST
+ * ============
+ */
+
+/**
+ * @brief Create a new sharded list.
+ * @param storage Caller-provided storage for the list, or NULL to allocate.
+ * @param allocator Allocation options, or NULL for the defaults.
+ * @param shards Number of shards, or 0 for one per online CPU.
+ * @param ordered Whether the list keeps appends in global append order.
+ * @return Pointer to the newly created list, or NULL on failure.
+ */
+List *sharded_list_create(List *storage, const ListAllocator *allocator,
+                          size_t shards, bool ordered) {
+  if (shards == 0) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    shards = (cpus > 0) ? (size_t)cpus : 1;
+  }
+  if (shards > SHARDED_MAX_SHARDS)
+    shards = SHARDED_MAX_SHARDS;
+
+  List *list = list_alloc_header(storage, LIST_SHARDED, allocator);
+  if (!list)
+    return NULL;
+
+  ShardedList *sharded_list = list_mem_aligned_alloc(
+      &list->allocator, LOCKFREE_CACHE_LINE,
+      sizeof(ShardedList) + shards * sizeof(ListShard));
+  if (!sharded_list) {
+    list_free_header(list);
+    return NULL;
+  }
+  pthread_mutex_init(&sharded_list->lock, NULL);
+  sentinel_list_init(&sharded_list->gathered);
+  sharded_list->gathered_size = 0;
+  sharded_list->next_ticket = 0;
+  sharded_list->shard_count = shards;
+  sharded_list->ordered = ordered;
+  for (size_t i = 0; i < shards; i++) {
+    ListShard *shard = &sharded_list->shards[i];
+    pthread_mutex_init(&shard->lock, NULL);
+    sentinel_list_init(&shard->list);
+    shard->size = 0;
+    shard->tickets = NULL;
+    shard->ticket_capacity = 0;
+  }
+
+  list->lists.sharded_list = sharded_list;
+  return list;
+}
+
+/**
+ * @brief Move every shard's nodes onto the end of the gathered list (list
+ * lock held). Ordered lists merge the shards by append ticket; a thread's
+ * own appends always keep their order.
+ * @param sharded_list Pointer to the sharded list.
+ */
+void sharded_list_gather(ShardedList *sharded_list) {
+  SentinelLinkedList *gathered = &sharded_list->gathered;
+  size_t taken[SHARDED_MAX_SHARDS] = {0};
+
+  for (size_t i = 0; i < sharded_list->shard_count; i++)
+    pthread_mutex_lock(&sharded_list->shards[i].lock);
+
+  if (!sharded_list->ordered) {
+    // Each shard moves over whole in O(1)
+    for (size_t i = 0; i < sharded_list->shard_count; i++)
+      sentinel_list_splice(gathered, gathered->size,
+                           &sharded_list->shards[i].list);
+  } else {
+    // Each shard's tickets rise, so repeatedly take the lowest front one
+    for (;;) {
+      ListShard *next = NULL;
+      size_t nextIndex = 0;
+      for (size_t i = 0; i < sharded_list->shard_count; i++) {
+        ListShard *shard = &sharded_list->shards[i];
+        if (shard->list.size > 0 &&
+            (!next || shard->tickets[taken[i]] <
+                          next->tickets[taken[nextIndex]])) {
+          next = shard;
+          nextIndex = i;
+        }
+      }
+      if (!next)
+        break;
+      Node *node = next->list.head->next;
+      sentinel_list_unlink(&next->list, node, 0);
+      sentinel_list_append(gathered, node);
+      taken[nextIndex] += 1;
+    }
+  }
+
+  // Publish the moved nodes before dropping them from the shard sizes: a
+  // list_size that sees a zeroed shard (acquire) also sees the new total, so
+  // it over- rather than under-counts
+  __atomic_store_n(&sharded_list->gathered_size, gathered->size,
+                   __ATOMIC_RELEASE);
+  for (size_t i = sharded_list->shard_count; i-- > 0;) {
+    ListShard *shard = &sharded_list->shards[i];
+    __atomic_store_n(&shard->size, 0, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&shard->lock);
+  }
+}
+
+/**
+ * @brief Take the list lock and gather the shards, for an operation on the
+ * global view. Appends keep going into the shards meanwhile.
+ * @param sharded_list Pointer to the sharded list.
+ * @return Pointer to the gathered list.
+ */
+SentinelLinkedList *sharded_list_lock(ShardedList *sharded_list) {
+  pthread_mutex_lock(&sharded_list->lock);
+  sharded_list_gather(sharded_list);
+  return &sharded_list->gathered;
+}
+
+void sharded_list_unlock(ShardedList *sharded_list) {
+  __atomic_store_n(&sharded_list->gathered_size,
+                   sharded_list->gathered.size, __ATOMIC_RELEASE);
+  pthread_mutex_unlock(&sharded_list->lock);
+}
+
+/**
+ * @brief Remove every element, keeping the list for reuse.
+ * @param list Pointer to the list to clear.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void sharded_list_clear(List *list, FreeFunc free_func) {
+  ShardedList *sharded_list = list->lists.sharded_list;
+  sentinel_list_release(sharded_list_lock(sharded_list), free_func);
+  sharded_list_unlock(sharded_list);
+}
+
+/**
+ * @brief Destroy the sharded list and free all associated memory. No other
+ * thread may still be using the list.
+ * @param list Pointer to the list to destroy.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void sharded_list_destroy(List *list, FreeFunc free_func) {
+  ShardedList *sharded_list = list->lists.sharded_list;
+  sharded_list_clear(list, free_func);
+  for (size_t i = 0; i < sharded_list->shard_count; i++) {
+    ListShard *shard = &sharded_list->shards[i];
+    pthread_mutex_destroy(&shard->lock);
+    list_mem_free(&list->allocator, shard->tickets);
+  }
+  pthread_mutex_destroy(&sharded_list->lock);
+  list_mem_free(&list->allocator, sharded_list);
+  list_free_header(list);
+}
+
+/**
+ * @brief Append a batch of nodes to the calling thread's shard. Only that
+ * shard is locked (and, for ordered lists, one ticket counter bumped).
+ * @param list Pointer to the sharded list (for its allocator).
+ * @param nodes Array of Node pointers, in order.
+ * @param count Number of nodes.
+ * @return true on success, false on failure.
+ */
+bool sharded_list_append_many(List *list, void **nodes, size_t count) {
+  ShardedList *sharded_list = list->lists.sharded_list;
+  ListShard *shard =
+      &sharded_list->shards[(list_thread_hash() >> 32) %
+                            sharded_list->shard_count];
+  pthread_mutex_lock(&shard->lock);
+
+  if (sharded_list->ordered) {
+    size_t needed = shard->list.size + count;
+    if (needed > shard->ticket_capacity) {
+      size_t capacity = (shard->ticket_capacity) ? shard->ticket_capacity : 16;
+      while (capacity < needed)
+        capacity *= 2;
+      uint64_t *tickets = list_mem_resize(
+          &list->allocator, shard->tickets,
+          shard->ticket_capacity * sizeof(uint64_t),
+          capacity * sizeof(uint64_t));
+      if (!tickets) {
+        pthread_mutex_unlock(&shard->lock);
+        return false;
+      }
+      shard->tickets = tickets;
+      shard->ticket_capacity = capacity;
+    }
+    // A batch takes consecutive tickets, so it stays together once merged
+    uint64_t ticket = __atomic_fetch_add(&sharded_list->next_ticket, count,
+                                         __ATOMIC_RELAXED);
+    for (size_t i = 0; i < count; i++)
+      shard->tickets[shard->list.size + i] = ticket + i;
+  }
+
+  sentinel_list_insert_many(&shard->list, shard->list.size, nodes, count);
+  __atomic_store_n(&shard->size, shard->list.size, __ATOMIC_RELEASE);
+  pthread_mutex_unlock(&shard->lock);
+  return true;
+}
+
+/**
+ * @brief Insert a batch of nodes into the global view at a specific index.
+ * @param sharded_list Pointer to the sharded list.
+ * @param index Index at which to insert the first node.
+ * @param nodes Array of Node pointers, in order.
+ * @param count Number of nodes.
+ * @return true on success, false if index is out of bounds.
+ */
+bool sharded_list_insert_many(ShardedList *sharded_list, size_t index,
+                              void **nodes, size_t count) {
+  bool inserted = sentinel_list_insert_many(sharded_list_lock(sharded_list),
+                                            index, nodes, count);
+  sharded_list_unlock(sharded_list);
+  return inserted;
+}
+
+/**
+ * @brief Move every node of `src` into `dst` at a specific index, holding
+ * both list locks (taken in address order).
+ * @param dst Pointer to the destination list.
+ * @param index Index in `dst` at which the nodes of `src` start (SIZE_MAX
+ * for its end).
+ * @param src Pointer to the source list (left empty).
+ * @return true on success, false if index is out of bounds.
+ */
+bool sharded_list_splice(ShardedList *dst, size_t index, ShardedList *src) {
+  ShardedList *first = (dst < src) ? dst : src;
+  ShardedList *second = (dst < src) ? src : dst;
+  sharded_list_lock(first);
+  sharded_list_lock(second);
+  if (index == SIZE_MAX)
+    index = dst->gathered.size;
+  bool spliced = sentinel_list_splice(&dst->gathered, index, &src->gathered);
+  sharded_list_unlock(second);
+  sharded_list_unlock(first);
+  return spliced;
+}
+
+/**
+ * @brief Move the nodes from `index` on into an empty (not yet shared) list.
+ * @param sharded_list Pointer to the list to split.
+ * @param index Index of the first node to move.
+ * @param suffix Pointer to the empty list receiving the nodes.
+ * @return true on success, false if index is out of bounds.
+ */
+bool sharded_list_split_at(ShardedList *sharded_list, size_t index,
+                           ShardedList *suffix) {
+  bool split = sentinel_list_split_at(sharded_list_lock(sharded_list), index,
+                                      &suffix->gathered);
+  suffix->gathered_size = suffix->gathered.size;
+  sharded_list_unlock(sharded_list);
+  return split;
+}
+
+void *sharded_list_remove(ShardedList *sharded_list, size_t index) {
+  void *removed = sentinel_list_remove(sharded_list_lock(sharded_list), index);
+  sharded_list_unlock(sharded_list);
+  return removed;
+}
+
+/**
+ * @brief Remove the first or last node of the global view.
+ * @param sharded_list Pointer to the sharded list.
+ * @param back true to pop the last node, false for the first.
+ * @return Pointer to the node, or NULL if the list is empty.
+ */
+void *sharded_list_pop(ShardedList *sharded_list, bool back) {
+  SentinelLinkedList *gathered = sharded_list_lock(sharded_list);
+  void *removed = (back) ? sentinel_list_pop_back(gathered)
+                         : sentinel_list_pop_front(gathered);
+  sharded_list_unlock(sharded_list);
+  return removed;
+}
+
+void *sharded_list_peek(ShardedList *sharded_list, bool back) {
+  SentinelLinkedList *gathered = sharded_list_lock(sharded_list);
+  void *node = (back) ? sentinel_list_peek_back(gathered)
+                      : sentinel_list_peek_front(gathered);
+  sharded_list_unlock(sharded_list);
+  return node;
+}
+
+/**
+ * @brief Get the node at a specific index of the global view. Sequential
+ * indices stay cheap: the gathered list keeps its finger.
+ * @param sharded_list Pointer to the sharded list.
+ * @param index Index of the node to retrieve.
+ * @return Pointer to the node, or NULL if index is out of bounds.
+ */
+void *sharded_list_get(ShardedList *sharded_list, size_t index) {
+  void *node = sentinel_list_get(sharded_list_lock(sharded_list), index);
+  sharded_list_unlock(sharded_list);
+  return node;
+}
+
+/**
+ * @brief Get the size of the list without taking any lock: every shard's
+ * size plus the gathered size (a snapshot while threads are appending). The
+ * shards are read first, since a gather zeroes them after raising the total.
+ * @param sharded_list Pointer to the sharded list.
+ * @return The number of elements in the list.
+ */
+size_t sharded_list_size(const ShardedList *sharded_list) {
+  size_t size = 0;
+  for (size_t i = 0; i < sharded_list->shard_count; i++)
+    size += __atomic_load_n(&sharded_list->shards[i].size, __ATOMIC_ACQUIRE);
+  return size + __atomic_load_n(&sharded_list->gathered_size, __ATOMIC_ACQUIRE);
+}
+
+/*
+ * =============
+ * BOUNDED QUEUE
+ * =============
+ */
+
+/**
+ * @brief Create a new bounded queue list.
+ * @param storage Caller-provided storage for the list, or NULL to allocate.
+ * @param allocator Allocation options, or NULL for the defaults.
+ * @param capacity Most elements the queue holds at once (at least 1).
+ * @return Pointer to the newly created list, or NULL on failure.
+ */
+List *bounded_queue_create(List *storage, const ListAllocator *allocator,
+                           size_t capacity) {
+  if (capacity == 0)
+    return NULL;
+
+  List *list = list_alloc_header(storage, LIST_BOUNDED, allocator);
+  if (!list)
+    return NULL;
+
+  BoundedQueue *queue = list_mem_alloc(&list->allocator, sizeof(BoundedQueue));
+  if (!queue) {
+    list_free_header(list);
+    return NULL;
+  }
+  // Timed waits run on the monotonic clock, so wall clock jumps can't
+  // stretch or cut them short
+  pthread_condattr_t attr;
+  pthread_condattr_init(&attr);
+  pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+  pthread_mutex_init(&queue->lock, NULL);
+  pthread_cond_init(&queue->not_empty, &attr);
+  pthread_cond_init(&queue->not_full, &attr);
+  pthread_condattr_destroy(&attr);
+  queue->capacity = capacity;
+  // A quarter of the capacity (rounded up): producers refill in bursts
+  queue->wake_batch = (capacity + 3) / 4;
+  queue->waiting_consumers = 0;
+  queue->waiting_producers = 0;
+  queue->waiting_batch_producers = 0;
+  queue->closed = false;
+  sentinel_list_init(&queue->list);
+
+  list->lists.bounded_queue = queue;
+  return list;
+}
+
+/**
+ * @brief Wake consumers waiting for elements after some were added (lock
+ * held): one for a single element, all of them for a batch.
+ * @param queue Pointer to the bounded queue.
+ * @param added Number of elements added.
+ */
+void bounded_queue_wake_consumers(BoundedQueue *queue, size_t added) {
+  if (queue->waiting_consumers == 0 || added == 0)
+    return;
+  if (added == 1)
+    pthread_cond_signal(&queue->not_empty);
+  else
+    pthread_cond_broadcast(&queue->not_empty);
+}
+
+/**
+ * @brief Wake producers waiting for room after elements were taken out (lock
+ * held): one per freed slot, or all of them once at least `wake_batch` slots
+ * are free. A waiting batch may need more room than the slot that woke it,
+ * so while one waits every producer is woken to recheck.
+ * @param queue Pointer to the bounded queue.
+ * @param removed Number of elements taken out.
+ */
+void bounded_queue_wake_producers(BoundedQueue *queue, size_t removed) {
+  if (queue->waiting_producers == 0 || removed == 0)
+    return;
+  if (queue->waiting_batch_producers > 0 ||
+      removed >= queue->waiting_producers ||
+      queue->capacity - queue->list.size >= queue->wake_batch) {
+    pthread_cond_broadcast(&queue->not_full);
+    return;
+  }
+  for (size_t i = 0; i < removed; i++)
+    pthread_cond_signal(&queue->not_full);
+}
+
+/**
+ * @brief Get the monotonic clock time a timeout from now.
+ * @param timeout_ms Timeout in milliseconds.
+ * @return The deadline.
+ */
+struct timespec bounded_queue_deadline(size_t timeout_ms) {
+  struct timespec deadline;
+  clock_gettime(CLOCK_MONOTONIC, &deadline);
+  deadline.tv_sec += (time_t)(timeout_ms / 1000);
+  deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+  if (deadline.tv_nsec >= 1000000000L) {
+    deadline.tv_sec += 1;
+    deadline.tv_nsec -= 1000000000L;
+  }
+  return deadline;
+}
+
+/**
+ * @brief Wait on one of the queue's conditions (lock held). The caller
+ * rechecks its condition afterwards, since wakeups may be spurious.
+ * @param queue Pointer to the bounded queue.
+ * @param cond Condition to wait on.
+ * @param waiting Waiter count to hold a place in while waiting.
+ * @param timeout_ms 0 to not wait, BOUNDED_WAIT_FOREVER to wait without a
+ * deadline, otherwise the timeout the deadline was computed from.
+ * @param deadline Monotonic clock time to give up at (timed waits only).
+ * @return true if woken, false if the wait was not allowed or timed out.
+ */
+bool bounded_queue_wait(BoundedQueue *queue, pthread_cond_t *cond,
+                        size_t *waiting, size_t timeout_ms,
+                        const struct timespec *deadline) {
+  if (timeout_ms == 0)
+    return false;
+  *waiting += 1;
+  int status = (timeout_ms == BOUNDED_WAIT_FOREVER)
+                   ? pthread_cond_wait(cond, &queue->lock)
+                   : pthread_cond_timedwait(cond, &queue->lock, deadline);
+  *waiting -= 1;
+  return status == 0;
+}
+
+/**
+ * @brief Remove every element, keeping the list for reuse (and closed if it
+ * was). Producers waiting for room are woken.
+ * @param list Pointer to the list to clear.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void bounded_queue_clear(List *list, FreeFunc free_func) {
+  BoundedQueue *queue = list->lists.bounded_queue;
+  pthread_mutex_lock(&queue->lock);
+  size_t removed = queue->list.size;
+  sentinel_list_release(&queue->list, free_func);
+  bounded_queue_wake_producers(queue, removed);
+  pthread_mutex_unlock(&queue->lock);
+}
+
+/**
+ * @brief Destroy the bounded queue and free all associated memory. No other
+ * thread may still be using the list (or waiting on it).
+ * @param list Pointer to the list to destroy.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void bounded_queue_destroy(List *list, FreeFunc free_func) {
+  BoundedQueue *queue = list->lists.bounded_queue;
+  sentinel_list_release(&queue->list, free_func);
+  pthread_cond_destroy(&queue->not_full);
+  pthread_cond_destroy(&queue->not_empty);
+  pthread_mutex_destroy(&queue->lock);
+  list_mem_free(&list->allocator, queue);
+  list_free_header(list);
+}
+
+/**
+ * @brief Close the queue: pushes fail from now on, and pops take what is
+ * left and then return NULL instead of waiting. Every waiter is woken.
+ * @param queue Pointer to the bounded queue.
+ */
+void bounded_queue_close(BoundedQueue *queue) {
+  pthread_mutex_lock(&queue->lock);
+  queue->closed = true;
+  pthread_cond_broadcast(&queue->not_empty);
+  pthread_cond_broadcast(&queue->not_full);
+  pthread_mutex_unlock(&queue->lock);
+}
+
+/**
+ * @brief Insert a batch of nodes at a specific index once there is room for
+ * all of them, waiting up to a timeout for it.
+ * @param queue Pointer to the bounded queue.
+ * @param index Index at which to insert the first node (SIZE_MAX appends).
+ * @param nodes Array of Node pointers, in order.
+ * @param count Number of nodes.
+ * @param timeout_ms 0 to fail at once when full, BOUNDED_WAIT_FOREVER to wait
+ * for as long as it takes, otherwise the most milliseconds to wait.
+ * @return true on success, false if index is out of bounds, the batch is
+ * larger than the capacity, the queue is closed or the wait timed out.
+ */
+bool bounded_queue_insert_many(BoundedQueue *queue, size_t index, void **nodes,
+                               size_t count, size_t timeout_ms) {
+  if (count > queue->capacity)
+    return false;
+  struct timespec deadline = {0, 0};
+  if (timeout_ms != 0 && timeout_ms != BOUNDED_WAIT_FOREVER)
+    deadline = bounded_queue_deadline(timeout_ms);
+
+  pthread_mutex_lock(&queue->lock);
+  if (count > 1)
+    queue->waiting_batch_producers += 1;
+  bool woken = true;
+  while (woken && !queue->closed &&
+         queue->list.size + count > queue->capacity)
+    woken = bounded_queue_wait(queue, &queue->not_full,
+                               &queue->waiting_producers, timeout_ms,
+                               &deadline);
+  if (count > 1)
+    queue->waiting_batch_producers -= 1;
+  bool inserted = false;
+  if (!queue->closed && queue->list.size + count <= queue->capacity) {
+    if (index == SIZE_MAX)
+      index = queue->list.size;
+    inserted = sentinel_list_insert_many(&queue->list, index, nodes, count);
+  }
+  if (inserted)
+    bounded_queue_wake_consumers(queue, count);
+  pthread_mutex_unlock(&queue->lock);
+  return inserted;
+}
+
+/**
+ * @brief Unlink the first or last node, waiting up to a timeout for one.
+ * @param queue Pointer to the bounded queue.
+ * @param back true to pop the last node, false for the first.
+ * @param timeout_ms 0 to return at once when empty, BOUNDED_WAIT_FOREVER to
+ * wait until an element arrives or the queue is closed, otherwise the most
+ * milliseconds to wait.
+ * @return Pointer to the node, or NULL if the queue stayed empty.
+ */
+void *bounded_queue_pop(BoundedQueue *queue, bool back, size_t timeout_ms) {
+  struct timespec deadline = {0, 0};
+  if (timeout_ms != 0 && timeout_ms != BOUNDED_WAIT_FOREVER)
+    deadline = bounded_queue_deadline(timeout_ms);
+
+  pthread_mutex_lock(&queue->lock);
+  bool woken = true;
+  while (woken && !queue->closed && queue->list.size == 0)
+    woken = bounded_queue_wait(queue, &queue->not_empty,
+                               &queue->waiting_consumers, timeout_ms,
+                               &deadline);
+  void *node = (back) ? sentinel_list_pop_back(&queue->list)
+                      : sentinel_list_pop_front(&queue->list);
+  if (node)
+    bounded_queue_wake_producers(queue, 1);
+  pthread_mutex_unlock(&queue->lock);
+  return node;
+}
+
+/**
+ * @brief Move every node of `src` into `dst` at a specific index, holding
+ * both locks (taken in address order so opposite splices can't deadlock).
+ * @param dst Pointer to the destination queue.
+ * @param index Index in `dst` at which the nodes of `src` start (SIZE_MAX for
+ * the end).
+ * @param src Pointer to the source queue (left empty).
+ * @return true on success, false if index is out of bounds, `dst` is closed
+ * or the nodes of `src` don't fit in it.
+ */
+bool bounded_queue_splice(BoundedQueue *dst, size_t index, BoundedQueue *src) {
+  BoundedQueue *first = (dst < src) ? dst : src;
+  BoundedQueue *second = (dst < src) ? src : dst;
+  pthread_mutex_lock(&first->lock);
+  pthread_mutex_lock(&second->lock);
+  size_t moved = src->list.size;
+  bool spliced = false;
+  if (!dst->closed && dst->list.size + moved <= dst->capacity) {
+    if (index == SIZE_MAX)
+      index = dst->list.size;
+    spliced = sentinel_list_splice(&dst->list, index, &src->list);
+  }
+  if (spliced) {
+    bounded_queue_wake_consumers(dst, moved);
+    bounded_queue_wake_producers(src, moved);
+  }
+  pthread_mutex_unlock(&second->lock);
+  pthread_mutex_unlock(&first->lock);
+  return spliced;
+}
+
+/**
+ * @brief Move the nodes from `index` on into an empty (not yet shared) queue
+ * of the same capacity.
+ * @param queue Pointer to the queue to split.
+ * @param index Index of the first node to move.
+ * @param suffix Pointer to the empty queue receiving the nodes.
+ * @return true on success, false if index is out of bounds.
+ */
+bool bounded_queue_split_at(BoundedQueue *queue, size_t index,
+                            BoundedQueue *suffix) {
+  pthread_mutex_lock(&queue->lock);
+  bool split = sentinel_list_split_at(&queue->list, index, &suffix->list);
+  if (split)
+    bounded_queue_wake_producers(queue, suffix->list.size);
+  pthread_mutex_unlock(&queue->lock);
+  return split;
+}
+
+/**
+ * @brief Remove the node at a specific index under the lock.
+ * @param queue Pointer to the bounded queue.
+ * @param index Index of the node to remove.
+ * @return Pointer to the removed node, or NULL if index is out of bounds.
+ */
+void *bounded_queue_remove(BoundedQueue *queue, size_t index) {
+  pthread_mutex_lock(&queue->lock);
+  void *removed = sentinel_list_remove(&queue->list, index);
+  if (removed)
+    bounded_queue_wake_producers(queue, 1);
+  pthread_mutex_unlock(&queue->lock);
+  return removed;
+}
+
+/**
+ * @brief Get the first or last node under the lock.
+ * @param queue Pointer to the bounded queue.
+ * @param back true for the last node, false for the first.
+ * @return Pointer to the node, or NULL if the queue is empty.
+ */
+void *bounded_queue_peek(BoundedQueue *queue, bool back) {
+  pthread_mutex_lock(&queue->lock);
+  void *node = (back) ? sentinel_list_peek_back(&queue->list)
+                      : sentinel_list_peek_front(&queue->list);
+  pthread_mutex_unlock(&queue->lock);
+  return node;
+}
+
+/**
+ * @brief Get the node at a specific index under the lock.
+ * @param queue Pointer to the bounded queue.
+ * @param index Index of the node to retrieve.
+ * @return Pointer to the node, or NULL if index is out of bounds.
+ */
+void *bounded_queue_get(BoundedQueue *queue, size_t index) {
+  pthread_mutex_lock(&queue->lock);
+  void *node = sentinel_list_get(&queue->list, index);
+  pthread_mutex_unlock(&queue->lock);
+  return node;
+}
+
+/**
+ * @brief Get the size of the queue under the lock.
+ * @param queue Pointer to the bounded queue.
+ * @return The number of elements in the queue.
+ */
+size_t bounded_queue_size(BoundedQueue *queue) {
+  pthread_mutex_lock(&queue->lock);
+  size_t size = sentinel_list_size(&queue->list);
+  pthread_mutex_unlock(&queue->lock);
+  return size;
+}
+
+/*
+ * =================
+ * PRIMARY FUNCTIONS
+ * =================
+ */
+
+List *list_create(ListType type) {
+  return list_create_with_allocator(type, NULL);
+}
+
+/**
+ * @brief Give a list its own node pool sized for the nodes its type pools.
+ * @param list Pointer to the (empty) list.
+ * @param allocator Allocation options.
+ * @return true on success (or when the type pools nothing), false on failure.
+ */
+bool list_attach_pool(List *list, const ListAllocator *allocator) {
+  size_t block_size = 0;
+  switch (list->type) {
+  case LIST_LINKED_SENTINEL:
+    block_size = (allocator->node_size) ? allocator->node_size : sizeof(Node);
+    break;
+  case LIST_UNROLLED:
+    block_size = sizeof(UnrolledNode);
+    break;
+  case LIST_TREE:
+    block_size = sizeof(TreeNode);
+    break;
+  case LIST_ARRAY:
+  case LIST_GAP_BUFFER:
+  case LIST_SKIP:
+    // Buffers and variable height nodes are not fixed-size blocks
+    return true;
+  case LIST_CONCURRENT:
+  case LIST_MPSC:
+  case LIST_DEQUE_LOCKFREE:
+  case LIST_RCU:
+  case LIST_SHARDED:
+  case LIST_BOUNDED:
+    // The pool's free list is not thread-safe
+    return true;
+  }
+
+  list->pool = node_pool_create(block_size, allocator->pool_slab_nodes,
+                                &list->allocator);
+  if (!list->pool)
+    return false;
+  if (list->type == LIST_UNROLLED)
+    list->lists.unrolled_list.pool = list->pool;
+  if (list->type == LIST_TREE)
+    list->lists.tree_list.pool = list->pool;
+  return true;
+}
+
+/**
+ * @brief Create a list of the specified type in caller storage or on the heap.
+ * @param storage Caller-provided storage for the list, or NULL to allocate.
+ * @param type The type of list to create.
+ * @param allocator Allocation options, or NULL for the defaults.
+ * @return Pointer to the list, or NULL on failure.
+ */
+List *list_create_in(List *storage, ListType type,
+                     const ListAllocator *allocator) {
   List *list = NULL; // could remain null
 
-  // List may have multiple implementations -- assume find by type
-  switch (type) {
+  // List may have multiple implementations -- assume find by type
+  switch (type) {
+  case LIST_LINKED_SENTINEL:
+    list = sentinel_list_create(storage, allocator);
+    break;
+  case LIST_ARRAY:
+    list = array_list_create(storage, allocator);
+    break;
+  case LIST_GAP_BUFFER:
+    list = gap_list_create(storage, allocator);
+    break;
+  case LIST_UNROLLED:
+    list = unrolled_list_create(storage, allocator);
+    break;
+  case LIST_SKIP:
+    list = skip_list_create(storage, allocator);
+    break;
+  case LIST_TREE:
+    list = tree_list_create(storage, allocator);
+    break;
+  case LIST_CONCURRENT:
+    list = concurrent_list_create(storage, allocator);
+    break;
+  case LIST_MPSC:
+    list = mpsc_queue_create(storage, allocator);
+    break;
+  case LIST_DEQUE_LOCKFREE:
+    list = lockfree_deque_create(storage, allocator);
+    break;
+  case LIST_RCU:
+    list = rcu_list_create(storage, allocator);
+    break;
+  case LIST_SHARDED:
+    // One shard per online CPU, unordered (see list_create_sharded)
+    list = sharded_list_create(storage, allocator, 0, false);
+    break;
+  case LIST_BOUNDED:
+    // See list_create_bounded for other capacities
+    list = bounded_queue_create(storage, allocator, BOUNDED_DEFAULT_CAPACITY);
+    break;
+  }
+
+  if (!list || !allocator || allocator->pool_slab_nodes == 0)
+    return list;
+
+  if (!list_attach_pool(list, allocator)) {
+    list_destroy(list, NULL);
+    return NULL;
+  }
+  return list;
+}
+
+List *list_create_with_allocator(ListType type,
+                                 const ListAllocator *allocator) {
+  return list_create_in(NULL, type, allocator);
+}
+
+bool list_init(List *storage, ListType type) {
+  if (!storage)
+    return false;
+  return list_create_in(storage, type, NULL) != NULL;
+}
+
+List *list_create_sharded(size_t shards, bool ordered) {
+  return sharded_list_create(NULL, NULL, shards, ordered);
+}
+
+List *list_create_bounded(size_t capacity) {
+  return bounded_queue_create(NULL, NULL, capacity);
+}
+
+/**
+ * @brief Create an empty list with the same type, allocator and node pool as
+ * another.
+ * @param list Pointer to the list to copy the configuration from.
+ * @return Pointer to the newly created list, or NULL on failure.
+ */
+List *list_create_like(const List *list) {
+  // Share the existing pool rather than creating a second one
+  ListAllocator allocator = list->allocator;
+  allocator.pool_slab_nodes = 0;
+  if (list->type == LIST_SHARDED) {
+    const ShardedList *sharded_list = list->lists.sharded_list;
+    return sharded_list_create(NULL, &allocator, sharded_list->shard_count,
+                               sharded_list->ordered);
+  }
+  if (list->type == LIST_BOUNDED)
+    return bounded_queue_create(NULL, &allocator,
+                                list->lists.bounded_queue->capacity);
+  List *newList = list_create_with_allocator(list->type, &allocator);
+  if (!newList || !list->pool)
+    return newList;
+
+  // Nodes may move between the two lists, so they share one pool
+  newList->pool = list->pool;
+  newList->pool->refs += 1;
+  if (list->type == LIST_UNROLLED)
+    newList->lists.unrolled_list.pool = list->pool;
+  if (list->type == LIST_TREE)
+    newList->lists.tree_list.pool = list->pool;
+  return newList;
+}
+
+void *list_node_alloc(List *list) {
+  if (list->type != LIST_LINKED_SENTINEL && list->type != LIST_CONCURRENT &&
+      list->type != LIST_MPSC && list->type != LIST_RCU &&
+      list->type != LIST_SHARDED && list->type != LIST_BOUNDED)
+    return NULL;
+
+  Node *node = (list->pool) ? node_pool_alloc(list->pool)
+                            : list_mem_alloc(&list->allocator, sizeof(Node));
+  if (!node)
+    return NULL;
+  node->type = NODE;
+  node->next = node->prev = NULL;
+  return node;
+}
+
+void list_node_free(List *list, void *node) {
+  if (!node)
+    return;
+  if (list->pool)
+    node_pool_free(list->pool, node);
+  else
+    list_mem_free(&list->allocator, node);
+}
+
+void list_destroy(List *list, FreeFunc free_func) {
+  switch (list->type) {
+  case LIST_LINKED_SENTINEL:
+    sentinel_list_destroy(list, free_func);
+    break;
+  case LIST_ARRAY:
+    array_list_destroy(list, free_func);
+    break;
+  case LIST_GAP_BUFFER:
+    gap_list_destroy(list, free_func);
+    break;
+  case LIST_UNROLLED:
+    unrolled_list_destroy(list, free_func);
+    break;
+  case LIST_SKIP:
+    skip_list_destroy(list, free_func);
+    break;
+  case LIST_TREE:
+    tree_list_destroy(list, free_func);
+    break;
+  case LIST_CONCURRENT:
+    concurrent_list_destroy(list, free_func);
+    break;
+  case LIST_MPSC:
+    mpsc_queue_destroy(list, free_func);
+    break;
+  case LIST_DEQUE_LOCKFREE:
+    lockfree_deque_destroy(list, free_func);
+    break;
+  case LIST_RCU:
+    rcu_list_destroy(list, free_func);
+    break;
+  case LIST_SHARDED:
+    sharded_list_destroy(list, free_func);
+    break;
+  case LIST_BOUNDED:
+    bounded_queue_destroy(list, free_func);
+    break;
+  }
+
+  // AI Use: Assisted by AI
+  // Used to find how to skip brackets marked as "untested" line
+  // NOTE: tests for brackets with no code behind it
+
+} // GCOVR_EXCL_LINE
+
+void list_clear(List *list, FreeFunc free_func) {
+  switch (list->type) {
+  case LIST_LINKED_SENTINEL:
+    sentinel_list_clear(list, free_func);
+    break;
+  case LIST_ARRAY:
+    array_list_clear(list, free_func);
+    break;
+  case LIST_GAP_BUFFER:
+    gap_list_clear(list, free_func);
+    break;
+  case LIST_UNROLLED:
+    unrolled_list_clear(list, free_func);
+    break;
+  case LIST_SKIP:
+    skip_list_clear(list, free_func);
+    break;
+  case LIST_TREE:
+    tree_list_clear(list, free_func);
+    break;
+  case LIST_CONCURRENT:
+    concurrent_list_clear(list, free_func);
+    break;
+  case LIST_MPSC:
+    mpsc_queue_clear(list, free_func);
+    break;
+  case LIST_DEQUE_LOCKFREE:
+    lockfree_deque_clear(list, free_func);
+    break;
+  case LIST_RCU:
+    rcu_list_clear(list, free_func);
+    break;
+  case LIST_SHARDED:
+    sharded_list_clear(list, free_func);
+    break;
+  case LIST_BOUNDED:
+    bounded_queue_clear(list, free_func);
+    break;
+  }
+} // GCOVR_EXCL_LINE
+
+void list_deinit(List *list, FreeFunc free_func) {
+  // Destroy leaves caller storage alone, so deinit is the same teardown
+  list_destroy(list, free_func);
+}
+
+bool list_append(List *list, void *data) {
+  Node *dataNode = data;
+  switch (list->type) {
+  case LIST_LINKED_SENTINEL:
+    // Check a node was passed in as data
+    // GCOVR_EXCL_START
+    if (dataNode->type != SENTINEL && dataNode->type != NODE)
+      return false;
+    // GCOVR_EXCL_STOP
+    return sentinel_list_append(&list->lists.sentinel_list, data);
+  case LIST_ARRAY:
+    return array_list_append(&list->lists.array_list, data);
+  case LIST_GAP_BUFFER:
+    return gap_list_append(&list->lists.gap_list, data);
+  case LIST_UNROLLED:
+    return unrolled_list_append(&list->lists.unrolled_list, data);
+  case LIST_SKIP:
+    return skip_list_append(&list->lists.skip_list, data);
+  case LIST_TREE:
+    return tree_list_append(&list->lists.tree_list, data);
+  case LIST_CONCURRENT:
+    // GCOVR_EXCL_START
+    if (dataNode->type != SENTINEL && dataNode->type != NODE)
+      return false;
+    // GCOVR_EXCL_STOP
+    return concurrent_list_append(list->lists.concurrent_list, dataNode);
+  case LIST_MPSC:
+    // GCOVR_EXCL_START
+    if (dataNode->type != SENTINEL && dataNode->type != NODE)
+      return false;
+    // GCOVR_EXCL_STOP
+    return mpsc_queue_push(list->lists.mpsc_queue, dataNode);
+  case LIST_DEQUE_LOCKFREE:
+    return lockfree_deque_push_back(list->lists.lockfree_deque, data);
+  case LIST_RCU:
+    // GCOVR_EXCL_START
+    if (dataNode->type != SENTINEL && dataNode->type != NODE)
+      return false;
+    // GCOVR_EXCL_STOP
+    return rcu_list_append(list->lists.rcu_list, dataNode);
+  case LIST_SHARDED: {
+    // GCOVR_EXCL_START
+    if (dataNode->type != SENTINEL && dataNode->type != NODE)
+      return false;
+    // GCOVR_EXCL_STOP
+    void *nodes[] = {dataNode};
+    return sharded_list_append_many(list, nodes, 1);
+  }
+  case LIST_BOUNDED: {
+    // GCOVR_EXCL_START
+    if (dataNode->type != SENTINEL && dataNode->type != NODE)
+      return false;
+    // GCOVR_EXCL_STOP
+    // Fails rather than waits when full (see list_push_back_wait)
+    void *nodes[] = {dataNode};
+    return bounded_queue_insert_many(list->lists.bounded_queue, SIZE_MAX,
+                                     nodes, 1, 0);
+  }
+  }
+} // GCOVR_EXCL_LINE
+
+bool list_insert(List *list, size_t index, void *data) {
+  Node *dataNode = data;
+  switch (list->type) {
+  case LIST_LINKED_SENTINEL:
+    // Check a node was passed in as data
+    // GCOVR_EXCL_START
+    if (dataNode->type != SENTINEL && dataNode->type != NODE)
+      return false;
+    // GCOVR_EXCL_STOP
+
+    // Insert node into list
+    return sentinel_list_insert(&list->lists.sentinel_list, index, dataNode);
+  case LIST_ARRAY:
+    return array_list_insert(&list->lists.array_list, index, data);
+  case LIST_GAP_BUFFER:
+    return gap_list_insert(&list->lists.gap_list, index, data);
+  case LIST_UNROLLED:
+    return unrolled_list_insert(&list->lists.unrolled_list, index, data);
+  case LIST_SKIP:
+    return skip_list_insert(&list->lists.skip_list, index, data);
+  case LIST_TREE:
+    return tree_list_insert(&list->lists.tree_list, index, data);
+  case LIST_CONCURRENT:
+    // GCOVR_EXCL_START
+    if (dataNode->type != SENTINEL && dataNode->type != NODE)
+      return false;
+    // GCOVR_EXCL_STOP
+    return concurrent_list_insert(list->lists.concurrent_list, index, dataNode);
+  case LIST_MPSC:
+    // Producers only append
+    return false;
+  case LIST_DEQUE_LOCKFREE:
+    // The owner only pushes at the back
+    if (index != lockfree_deque_size(list->lists.lockfree_deque))
+      return false;
+    return lockfree_deque_push_back(list->lists.lockfree_deque, data);
+  case LIST_RCU:
+    // GCOVR_EXCL_START
+    if (dataNode->type != SENTINEL && dataNode->type != NODE)
+      return false;
+    // GCOVR_EXCL_STOP
+    return rcu_list_insert(list->lists.rcu_list, index, dataNode);
+  case LIST_SHARDED: {
+    // GCOVR_EXCL_START
+    if (dataNode->type != SENTINEL && dataNode->type != NODE)
+      return false;
+    // GCOVR_EXCL_STOP
+    void *nodes[] = {dataNode};
+    return sharded_list_insert_many(list->lists.sharded_list, index, nodes, 1);
+  }
+  case LIST_BOUNDED: {
+    // GCOVR_EXCL_START
+    if (dataNode->type != SENTINEL && dataNode->type != NODE)
+      return false;
+    // GCOVR_EXCL_STOP
+    void *nodes[] = {dataNode};
+    return bounded_queue_insert_many(list->lists.bounded_queue, index, nodes,
+                                     1, 0);
+  }
+  }
+} // GCOVR_EXCL_LINE
+
+bool list_append_many(List *list, void **items, size_t count) {
+  // Resolve the end under the lock, not from a size other threads may change
+  if (list->type == LIST_CONCURRENT) {
+    for (size_t i = 0; i < count; i++) {
+      Node *dataNode = items[i];
+      if (!dataNode || (dataNode->type != SENTINEL && dataNode->type != NODE))
+        return false;
+    }
+    ConcurrentList *concurrent_list = list->lists.concurrent_list;
+    pthread_rwlock_wrlock(&concurrent_list->lock);
+    bool appended = sentinel_list_insert_many(
+        &concurrent_list->list, sentinel_list_size(&concurrent_list->list),
+        items, count);
+    pthread_rwlock_unlock(&concurrent_list->lock);
+    return appended;
+  }
+  if (list->type == LIST_MPSC || list->type == LIST_SHARDED ||
+      list->type == LIST_BOUNDED) {
+    for (size_t i = 0; i < count; i++) {
+      Node *dataNode = items[i];
+      if (!dataNode || (dataNode->type != SENTINEL && dataNode->type != NODE))
+        return false;
+    }
+    // Appends only touch the caller's shard
+    if (list->type == LIST_SHARDED)
+      return sharded_list_append_many(list, items, count);
+    // All or nothing, with one wakeup for the whole batch
+    if (list->type == LIST_BOUNDED)
+      return bounded_queue_insert_many(list->lists.bounded_queue, SIZE_MAX,
+                                       items, count, 0);
+    return mpsc_queue_push_many(list->lists.mpsc_queue, items, count);
+  }
+  // SIZE_MAX has the RCU writer resolve the end under its lock
+  if (list->type == LIST_RCU)
+    return list_insert_many(list, SIZE_MAX, items, count);
+  return list_insert_many(list, list_size(list), items, count);
+}
+
+bool list_insert_many(List *list, size_t index, void **items, size_t count) {
+  // Validate the whole batch first so a bad element inserts nothing
+  for (size_t i = 0; i < count; i++) {
+    Node *dataNode = items[i];
+    if (!dataNode)
+      return false;
+    if ((list->type == LIST_LINKED_SENTINEL ||
+         list->type == LIST_CONCURRENT || list->type == LIST_MPSC ||
+         list->type == LIST_RCU || list->type == LIST_SHARDED ||
+         list->type == LIST_BOUNDED) &&
+        dataNode->type != SENTINEL && dataNode->type != NODE)
+      return false;
+  }
+
+  switch (list->type) {
+  case LIST_LINKED_SENTINEL:
+    return sentinel_list_insert_many(&list->lists.sentinel_list, index, items,
+                                     count);
+  case LIST_ARRAY:
+    return array_list_insert_many(&list->lists.array_list, index, items, count);
+  case LIST_GAP_BUFFER:
+    return gap_list_insert_many(&list->lists.gap_list, index, items, count);
+  case LIST_UNROLLED: {
+    UnrolledList *unrolled_list = &list->lists.unrolled_list;
+    size_t before = unrolled_list->size;
+    if (unrolled_list_insert_many(unrolled_list, index, items, count))
+      return true;
+    // A block allocation failed part way: take the inserted prefix back out
+    while (unrolled_list->size > before)
+      unrolled_list_remove(unrolled_list, index);
+    return false;
+  }
+  case LIST_CONCURRENT:
+    return concurrent_list_insert_many(list->lists.concurrent_list, index,
+                                       items, count);
+  case LIST_RCU:
+    // Readers see the whole batch appear at once
+    return rcu_list_insert_many(list->lists.rcu_list, index, items, count);
+  case LIST_SHARDED:
+    return sharded_list_insert_many(list->lists.sharded_list, index, items,
+                                    count);
+  case LIST_BOUNDED:
+    return bounded_queue_insert_many(list->lists.bounded_queue, index, items,
+                                     count, 0);
+  case LIST_MPSC:
+    // Producers only append
+    return false;
+  case LIST_SKIP:
+  case LIST_TREE:
+  case LIST_DEQUE_LOCKFREE:
+    // Each insert is O(log n) (or O(1)) already; no cheaper batch path
+    if (index > list_size(list))
+      return false;
+    for (size_t i = 0; i < count; i++) {
+      if (!list_insert(list, index + i, items[i])) {
+        // Take the inserted prefix back out (the deque only pushes at the back)
+        while (i-- > 0) {
+          if (list->type == LIST_DEQUE_LOCKFREE)
+            list_pop_back(list);
+          else
+            list_remove(list, index);
+        }
+        return false;
+      }
+    }
+    return true;
+  }
+  return false; // GCOVR_EXCL_LINE
+}
+
+bool list_splice(List *dst, size_t index, List *src) {
+  // Lock-free types only move elements through their own push and pop, and a
+  // reader could follow an RCU node moved mid-walk into the other list
+  if (dst == src || dst->type != src->type || dst->type == LIST_MPSC ||
+      dst->type == LIST_DEQUE_LOCKFREE || dst->type == LIST_RCU)
+    return false;
+  // Concurrent lists check the index under their locks
+  if (dst->type == LIST_CONCURRENT)
+    return concurrent_list_splice(dst->lists.concurrent_list, index,
+                                  src->lists.concurrent_list);
+  // Sharded lists resolve the index once their shards are gathered
+  if (dst->type == LIST_SHARDED)
+    return sharded_list_splice(dst->lists.sharded_list, index,
+                               src->lists.sharded_list);
+  // Bounded queues also check the capacity under their locks
+  if (dst->type == LIST_BOUNDED)
+    return bounded_queue_splice(dst->lists.bounded_queue, index,
+                                src->lists.bounded_queue);
+  if (index > list_size(dst))
+    return false;
+
+  switch (dst->type) {
+  case LIST_LINKED_SENTINEL:
+    // Pooled element nodes die with their pool's slabs, so they can only
+    // move between lists sharing it
+    if (dst->pool != src->pool)
+      return false;
+    return sentinel_list_splice(&dst->lists.sentinel_list, index,
+                                &src->lists.sentinel_list);
+  case LIST_ARRAY:
+    return array_list_splice(&dst->lists.array_list, index,
+                             &src->lists.array_list);
+  case LIST_GAP_BUFFER:
+    return gap_list_splice(&dst->lists.gap_list, index, &src->lists.gap_list);
+  case LIST_UNROLLED:
+    // Blocks can only be relinked between lists drawing from the same pool
+    // and allocator hooks, since dst frees them once they're its own
+    if (dst->pool == src->pool &&
+        list_mem_same(&dst->allocator, &src->allocator))
+      return unrolled_list_splice(&dst->lists.unrolled_list, index,
+                                  &src->lists.unrolled_list);
+    // fall through
+  case LIST_SKIP:
+  case LIST_TREE:
+  case LIST_CONCURRENT: // handled above
+  case LIST_SHARDED:    // handled above
+  case LIST_BOUNDED:    // handled above
+  case LIST_MPSC:           // rejected above
+  case LIST_DEQUE_LOCKFREE: // rejected above
+  case LIST_RCU:            // rejected above
+    // Move elements back to front so each lands in front of the previous one
+    for (size_t moved = 0; !list_is_empty(src); moved++) {
+      void *data = list_remove(src, list_size(src) - 1);
+      if (!list_insert(dst, index, data)) {
+        // Hand the moved elements back, in order, so nothing is half done
+        list_append(src, data);
+        for (size_t i = 0; i < moved; i++)
+          list_append(src, list_remove(dst, index));
+        return false;
+      }
+    }
+    return true;
+  }
+  return false; // GCOVR_EXCL_LINE
+}
+
+bool list_concat(List *dst, List *src) {
+  if (dst->type == LIST_CONCURRENT && dst != src &&
+      dst->type == src->type) {
+    // Resolve the end under the locks, not from a size that may change
+    ConcurrentList *first = dst->lists.concurrent_list;
+    ConcurrentList *second = src->lists.concurrent_list;
+    if (second < first) {
+      first = src->lists.concurrent_list;
+      second = dst->lists.concurrent_list;
+    }
+    pthread_rwlock_wrlock(&first->lock);
+    pthread_rwlock_wrlock(&second->lock);
+    SentinelLinkedList *dstList = &dst->lists.concurrent_list->list;
+    bool spliced = sentinel_list_splice(dstList, sentinel_list_size(dstList),
+                                        &src->lists.concurrent_list->list);
+    pthread_rwlock_unlock(&second->lock);
+    pthread_rwlock_unlock(&first->lock);
+    return spliced;
+  }
+  if (dst->type == LIST_SHARDED && dst != src && dst->type == src->type)
+    return sharded_list_splice(dst->lists.sharded_list, SIZE_MAX,
+                               src->lists.sharded_list);
+  if (dst->type == LIST_BOUNDED && dst != src && dst->type == src->type)
+    return bounded_queue_splice(dst->lists.bounded_queue, SIZE_MAX,
+                                src->lists.bounded_queue);
+  return list_splice(dst, list_size(dst), src);
+}
+
+List *list_split_at(List *list, size_t index) {
+  // Concurrent, sharded and bounded lists check the index under their lock
+  if (list->type == LIST_MPSC || list->type == LIST_DEQUE_LOCKFREE ||
+      list->type == LIST_RCU ||
+      (list->type != LIST_CONCURRENT && list->type != LIST_SHARDED &&
+       list->type != LIST_BOUNDED && index > list_size(list)))
+    return NULL;
+
+  List *suffix = list_create_like(list);
+  if (!suffix)
+    return NULL;
+
+  bool split = false;
+  switch (list->type) {
+  case LIST_LINKED_SENTINEL:
+    split = sentinel_list_split_at(&list->lists.sentinel_list, index,
+                                   &suffix->lists.sentinel_list);
+    break;
+  case LIST_ARRAY:
+    split = array_list_split_at(&list->lists.array_list, index,
+                                &suffix->lists.array_list);
+    break;
+  case LIST_GAP_BUFFER:
+    split = gap_list_split_at(&list->lists.gap_list, index,
+                              &suffix->lists.gap_list);
+    break;
+  case LIST_UNROLLED:
+    split = unrolled_list_split_at(&list->lists.unrolled_list, index,
+                                   &suffix->lists.unrolled_list);
+    break;
+  case LIST_CONCURRENT:
+    split = concurrent_list_split_at(list->lists.concurrent_list, index,
+                                     suffix->lists.concurrent_list);
+    break;
+  case LIST_SHARDED:
+    split = sharded_list_split_at(list->lists.sharded_list, index,
+                                  suffix->lists.sharded_list);
+    break;
+  case LIST_BOUNDED:
+    split = bounded_queue_split_at(list->lists.bounded_queue, index,
+                                   suffix->lists.bounded_queue);
+    break;
+  case LIST_MPSC:           // rejected above
+  case LIST_DEQUE_LOCKFREE: // rejected above
+  case LIST_RCU:            // rejected above
+    break;
+  case LIST_SKIP:
+  case LIST_TREE:
+    // Peel elements off one at a time (O(log n) each)
+    split = true;
+    while (split && list_size(list) > index) {
+      void *data = list_remove(list, index);
+      split = list_append(suffix, data);
+      if (!split)
+        list_insert(list, index, data); // GCOVR_EXCL_LINE
+    }
+    if (!split)
+      list_splice(list, index, suffix); // GCOVR_EXCL_LINE
+    break;
+  }
+
+  if (!split) {
+    list_destroy(suffix, NULL);
+    return NULL;
+  }
+  return suffix;
+}
+
+void *list_remove(List *list, size_t index) {
+  switch (list->type) {
+  case LIST_LINKED_SENTINEL:
+    return sentinel_list_remove(&list->lists.sentinel_list, index);
+  case LIST_ARRAY:
+    return array_list_remove(&list->lists.array_list, index);
+  case LIST_GAP_BUFFER:
+    return gap_list_remove(&list->lists.gap_list, index);
+  case LIST_UNROLLED:
+    return unrolled_list_remove(&list->lists.unrolled_list, index);
+  case LIST_SKIP:
+    return skip_list_remove(&list->lists.skip_list, index);
+  case LIST_TREE:
+    return tree_list_remove(&list->lists.tree_list, index);
+  case LIST_CONCURRENT:
+    return concurrent_list_remove(list->lists.concurrent_list, index);
+  case LIST_MPSC:
+    // The consumer only pops the front
+    return (index == 0) ? mpsc_queue_pop(list->lists.mpsc_queue) : NULL;
+  case LIST_DEQUE_LOCKFREE: {
+    // Only the two ends: a steal at the front, an owner pop at the back
+    LockFreeDeque *deque = list->lists.lockfree_deque;
+    if (index == 0)
+      return lockfree_deque_steal(deque);
+    if (index + 1 == lockfree_deque_size(deque))
+      return lockfree_deque_pop_back(deque);
+    return NULL;
+  }
+  case LIST_RCU:
+    // Returns once no reader can still see the node
+    return rcu_list_remove(list->lists.rcu_list, index);
+  case LIST_SHARDED:
+    return sharded_list_remove(list->lists.sharded_list, index);
+  case LIST_BOUNDED:
+    return bounded_queue_remove(list->lists.bounded_queue, index);
+  }
+} // GCOVR_EXCL_LINE
+
+bool list_push_front(List *list, void *data) {
+  Node *dataNode = data;
+  switch (list->type) {
+  case LIST_LINKED_SENTINEL:
+    // GCOVR_EXCL_START
+    if (dataNode->type != SENTINEL && dataNode->type != NODE)
+      return false;
+    // GCOVR_EXCL_STOP
+    return sentinel_list_push_front(&list->lists.sentinel_list, dataNode);
+  case LIST_ARRAY:
+    return array_list_insert(&list->lists.array_list, 0, data);
+  case LIST_GAP_BUFFER:
+    return gap_list_insert(&list->lists.gap_list, 0, data);
+  case LIST_UNROLLED:
+    return unrolled_list_push_front(&list->lists.unrolled_list, data);
+  case LIST_SKIP:
+    return skip_list_insert(&list->lists.skip_list, 0, data);
+  case LIST_TREE:
+    return tree_list_insert(&list->lists.tree_list, 0, data);
+  case LIST_CONCURRENT:
+    // GCOVR_EXCL_START
+    if (dataNode->type != SENTINEL && dataNode->type != NODE)
+      return false;
+    // GCOVR_EXCL_STOP
+    return concurrent_list_push_front(list->lists.concurrent_list, dataNode);
+  case LIST_MPSC:
+    // Producers only append
+    return false;
+  case LIST_DEQUE_LOCKFREE:
+    // Only thieves touch the front of a work-stealing deque
+    return false;
+  case LIST_RCU:
+    // GCOVR_EXCL_START
+    if (dataNode->type != SENTINEL && dataNode->type != NODE)
+      return false;
+    // GCOVR_EXCL_STOP
+    return rcu_list_insert(list->lists.rcu_list, 0, dataNode);
+  case LIST_SHARDED: {
+    // GCOVR_EXCL_START
+    if (dataNode->type != SENTINEL && dataNode->type != NODE)
+      return false;
+    // GCOVR_EXCL_STOP
+    void *nodes[] = {dataNode};
+    return sharded_list_insert_many(list->lists.sharded_list, 0, nodes, 1);
+  }
+  case LIST_BOUNDED: {
+    // GCOVR_EXCL_START
+    if (dataNode->type != SENTINEL && dataNode->type != NODE)
+      return false;
+    // GCOVR_EXCL_STOP
+    void *nodes[] = {dataNode};
+    return bounded_queue_insert_many(list->lists.bounded_queue, 0, nodes, 1,
+                                     0);
+  }
+  }
+  return false; // GCOVR_EXCL_LINE
+}
+
+bool list_push_back(List *list, void *data) {
+  // Every type already appends without a positional lookup
+  return list_append(list, data);
+}
+
+void *list_pop_front(List *list) {
+  switch (list->type) {
+  case LIST_LINKED_SENTINEL:
+    return sentinel_list_pop_front(&list->lists.sentinel_list);
+  case LIST_ARRAY:
+    return array_list_remove(&list->lists.array_list, 0);
+  case LIST_GAP_BUFFER:
+    return gap_list_remove(&list->lists.gap_list, 0);
+  case LIST_UNROLLED:
+    return unrolled_list_pop_front(&list->lists.unrolled_list);
+  case LIST_SKIP:
+    return skip_list_remove(&list->lists.skip_list, 0);
+  case LIST_TREE:
+    return tree_list_remove(&list->lists.tree_list, 0);
+  case LIST_CONCURRENT:
+    return concurrent_list_pop(list->lists.concurrent_list, false);
+  case LIST_MPSC:
+    return mpsc_queue_pop(list->lists.mpsc_queue);
+  case LIST_DEQUE_LOCKFREE:
+    return lockfree_deque_steal(list->lists.lockfree_deque);
+  case LIST_RCU:
+    return rcu_list_remove(list->lists.rcu_list, 0);
+  case LIST_SHARDED:
+    return sharded_list_pop(list->lists.sharded_list, false);
+  case LIST_BOUNDED:
+    // Returns NULL rather than waits when empty (see list_pop_front_wait)
+    return bounded_queue_pop(list->lists.bounded_queue, false, 0);
+  }
+  return NULL; // GCOVR_EXCL_LINE
+}
+
+void *list_pop_back(List *list) {
+  switch (list->type) {
+  case LIST_LINKED_SENTINEL:
+    return sentinel_list_pop_back(&list->lists.sentinel_list);
+  case LIST_ARRAY:
+    return array_list_pop_back(&list->lists.array_list);
+  case LIST_GAP_BUFFER: {
+    GapBufferList *gap_list = &list->lists.gap_list;
+    size_t size = gap_list_size(gap_list);
+    return (size > 0) ? gap_list_remove(gap_list, size - 1) : NULL;
+  }
+  case LIST_UNROLLED:
+    return unrolled_list_pop_back(&list->lists.unrolled_list);
+  case LIST_SKIP: {
+    SkipList *skip_list = &list->lists.skip_list;
+    return (skip_list->size > 0) ? skip_list_remove(skip_list,
+                                                    skip_list->size - 1)
+                                 : NULL;
+  }
+  case LIST_TREE: {
+    TreeList *tree_list = &list->lists.tree_list;
+    size_t size = tree_list_size(tree_list);
+    return (size > 0) ? tree_list_remove(tree_list, size - 1) : NULL;
+  }
+  case LIST_CONCURRENT:
+    return concurrent_list_pop(list->lists.concurrent_list, true);
+  case LIST_MPSC:
+    // The consumer only pops the front
+    return NULL;
+  case LIST_DEQUE_LOCKFREE:
+    return lockfree_deque_pop_back(list->lists.lockfree_deque);
+  case LIST_RCU:
+    // The writer resolves the last index under its lock
+    return rcu_list_remove(list->lists.rcu_list, SIZE_MAX);
+  case LIST_SHARDED:
+    return sharded_list_pop(list->lists.sharded_list, true);
+  case LIST_BOUNDED:
+    return bounded_queue_pop(list->lists.bounded_queue, true, 0);
+  }
+  return NULL; // GCOVR_EXCL_LINE
+}
+
+void *list_peek_front(const List *list) {
+  switch (list->type) {
+  case LIST_LINKED_SENTINEL:
+    return sentinel_list_peek_front(&list->lists.sentinel_list);
+  case LIST_ARRAY:
+    return array_list_get(&list->lists.array_list, 0);
+  case LIST_GAP_BUFFER:
+    return gap_list_get(&list->lists.gap_list, 0);
+  case LIST_UNROLLED: {
+    const UnrolledList *unrolled_list = &list->lists.unrolled_list;
+    return (unrolled_list->size > 0) ? unrolled_list->head->items[0] : NULL;
+  }
+  case LIST_SKIP:
+    return skip_list_get(&list->lists.skip_list, 0);
+  case LIST_TREE:
+    return tree_list_get(&list->lists.tree_list, 0);
+  case LIST_CONCURRENT:
+    return concurrent_list_peek(list->lists.concurrent_list, false);
+  case LIST_MPSC:
+    return mpsc_queue_next(list->lists.mpsc_queue, NULL);
+  case LIST_DEQUE_LOCKFREE:
+    return lockfree_deque_get(list->lists.lockfree_deque, 0);
+  case LIST_RCU:
+    return rcu_list_peek(list->lists.rcu_list, false);
+  case LIST_SHARDED:
+    return sharded_list_peek(list->lists.sharded_list, false);
+  case LIST_BOUNDED:
+    return bounded_queue_peek(list->lists.bounded_queue, false);
+  }
+  return NULL; // GCOVR_EXCL_LINE
+}
+
+void *list_peek_back(const List *list) {
+  switch (list->type) {
+  case LIST_LINKED_SENTINEL:
+    return sentinel_list_peek_back(&list->lists.sentinel_list);
+  case LIST_ARRAY: {
+    const ArrayList *array_list = &list->lists.array_list;
+    return (array_list->size > 0) ? array_list->items[array_list->size - 1]
+                                  : NULL;
+  }
+  case LIST_GAP_BUFFER: {
+    const GapBufferList *gap_list = &list->lists.gap_list;
+    size_t size = gap_list_size(gap_list);
+    return (size > 0) ? gap_list_get(gap_list, size - 1) : NULL;
+  }
+  case LIST_UNROLLED: {
+    const UnrolledList *unrolled_list = &list->lists.unrolled_list;
+    if (unrolled_list->size == 0)
+      return NULL;
+    return unrolled_list->tail->items[unrolled_list->tail->count - 1];
+  }
+  case LIST_SKIP: {
+    const SkipList *skip_list = &list->lists.skip_list;
+    return (skip_list->size > 0) ? skip_list_get(skip_list,
+                                                 skip_list->size - 1)
+                                 : NULL;
+  }
+  case LIST_TREE: {
+    const TreeList *tree_list = &list->lists.tree_list;
+    size_t size = tree_list_size(tree_list);
+    return (size > 0) ? tree_list_get(tree_list, size - 1) : NULL;
+  }
+  case LIST_CONCURRENT:
+    return concurrent_list_peek(list->lists.concurrent_list, true);
+  case LIST_MPSC:
+    return mpsc_queue_peek_back(list->lists.mpsc_queue);
+  case LIST_DEQUE_LOCKFREE: {
+    LockFreeDeque *deque = list->lists.lockfree_deque;
+    size_t size = lockfree_deque_size(deque);
+    return (size > 0) ? lockfree_deque_get(deque, size - 1) : NULL;
+  }
+  case LIST_RCU:
+    return rcu_list_peek(list->lists.rcu_list, true);
+  case LIST_SHARDED:
+    return sharded_list_peek(list->lists.sharded_list, true);
+  case LIST_BOUNDED:
+    return bounded_queue_peek(list->lists.bounded_queue, true);
+  }
+  return NULL; // GCOVR_EXCL_LINE
+}
+
+void *list_get(const List *list, size_t index) {
+  switch (list->type) {
+  case LIST_LINKED_SENTINEL:
+    // The finger is a lookup cache, so updating it through a const list is
+    // fine (lists are never defined const), but it makes this a write
+    return sentinel_list_get((SentinelLinkedList *)&list->lists.sentinel_list,
+                             index);
+  case LIST_ARRAY:
+    return array_list_get(&list->lists.array_list, index);
+  case LIST_GAP_BUFFER:
+    return gap_list_get(&list->lists.gap_list, index);
+  case LIST_UNROLLED:
+    return unrolled_list_get(&list->lists.unrolled_list, index);
+  case LIST_SKIP:
+    return skip_list_get(&list->lists.skip_list, index);
+  case LIST_TREE:
+    return tree_list_get(&list->lists.tree_list, index);
+  case LIST_CONCURRENT:
+    return concurrent_list_get(list->lists.concurrent_list, index);
+  case LIST_MPSC:
+    return mpsc_queue_get(list->lists.mpsc_queue, index);
+  case LIST_DEQUE_LOCKFREE:
+    return lockfree_deque_get(list->lists.lockfree_deque, index);
+  case LIST_RCU:
+    return rcu_list_get(list->lists.rcu_list, index);
+  case LIST_SHARDED:
+    return sharded_list_get(list->lists.sharded_list, index);
+  case LIST_BOUNDED:
+    return bounded_queue_get(list->lists.bounded_queue, index);
+  }
+} // GCOVR_EXCL_LINE
+
+size_t list_size(const List *list) {
+  switch (list->type) {
+  case LIST_LINKED_SENTINEL:
+    return sentinel_list_size(&list->lists.sentinel_list);
+  case LIST_ARRAY:
+    return array_list_size(&list->lists.array_list);
+  case LIST_GAP_BUFFER:
+    return gap_list_size(&list->lists.gap_list);
+  case LIST_UNROLLED:
+    return unrolled_list_size(&list->lists.unrolled_list);
+  case LIST_SKIP:
+    return skip_list_size(&list->lists.skip_list);
+  case LIST_TREE:
+    return tree_list_size(&list->lists.tree_list);
+  case LIST_CONCURRENT:
+    return concurrent_list_size(list->lists.concurrent_list);
+  case LIST_MPSC:
+    return mpsc_queue_size(list->lists.mpsc_queue);
+  case LIST_DEQUE_LOCKFREE:
+    return lockfree_deque_size(list->lists.lockfree_deque);
+  case LIST_RCU:
+    return rcu_list_size(list->lists.rcu_list);
+  case LIST_SHARDED:
+    return sharded_list_size(list->lists.sharded_list);
+  case LIST_BOUNDED:
+    return bounded_queue_size(list->lists.bounded_queue);
+  }
+} // GCOVR_EXCL_LINE
+
+bool list_is_empty(const List *list) {
+  switch (list->type) {
+  case LIST_LINKED_SENTINEL:
+    return sentinel_list_size(&list->lists.sentinel_list) == 0;
+  case LIST_ARRAY:
+    return array_list_size(&list->lists.array_list) == 0;
+  case LIST_GAP_BUFFER:
+    return gap_list_size(&list->lists.gap_list) == 0;
+  case LIST_UNROLLED:
+    return unrolled_list_size(&list->lists.unrolled_list) == 0;
+  case LIST_SKIP:
+    return skip_list_size(&list->lists.skip_list) == 0;
+  case LIST_TREE:
+    return tree_list_size(&list->lists.tree_list) == 0;
+  case LIST_CONCURRENT:
+    return concurrent_list_size(list->lists.concurrent_list) == 0;
+  case LIST_MPSC:
+    return mpsc_queue_size(list->lists.mpsc_queue) == 0;
+  case LIST_DEQUE_LOCKFREE:
+    return lockfree_deque_size(list->lists.lockfree_deque) == 0;
+  case LIST_RCU:
+    return rcu_list_size(list->lists.rcu_list) == 0;
+  case LIST_SHARDED:
+    return sharded_list_size(list->lists.sharded_list) == 0;
+  case LIST_BOUNDED:
+    return bounded_queue_size(list->lists.bounded_queue) == 0;
+  }
+} // GCOVR_EXCL_LINE
+
+size_t list_rcu_read_lock(const List *list) {
+  if (list->type != LIST_RCU)
+    return 0;
+  return rcu_list_read_lock(list->lists.rcu_list);
+}
+
+void list_rcu_read_unlock(const List *list, size_t token) {
+  if (list->type == LIST_RCU)
+    rcu_list_read_unlock(list->lists.rcu_list, token);
+}
+
+bool list_push_back_wait(List *list, void *data) {
+  return list_push_back_timed(list, data, BOUNDED_WAIT_FOREVER);
+}
+
+bool list_push_back_timed(List *list, void *data, size_t timeout_ms) {
+  // Other types never fill up, so there is nothing to wait for
+  if (list->type != LIST_BOUNDED)
+    return list_push_back(list, data);
+  Node *dataNode = data;
+  if (!dataNode || (dataNode->type != SENTINEL && dataNode->type != NODE))
+    return false;
+  void *nodes[] = {dataNode};
+  return bounded_queue_insert_many(list->lists.bounded_queue, SIZE_MAX, nodes,
+                                   1, timeout_ms);
+}
+
+void *list_pop_front_wait(List *list) {
+  return list_pop_front_timed(list, BOUNDED_WAIT_FOREVER);
+}
+
+void *list_pop_front_timed(List *list, size_t timeout_ms) {
+  if (list->type != LIST_BOUNDED)
+    return list_pop_front(list);
+  return bounded_queue_pop(list->lists.bounded_queue, false, timeout_ms);
+}
+
+void list_bounded_close(List *list) {
+  if (list->type == LIST_BOUNDED)
+    bounded_queue_close(list->lists.bounded_queue);
+}
+
+/*
+ * =========
+ * ITERATORS
+ * =========
+ */
+
+/**
+ * @brief Get the number of elements a cursor can reach: for a sharded list
+ * only the gathered ones, since appends waiting in the shards aren't linked
+ * in yet.
+ * @param list Pointer to the list.
+ * @return The number of reachable elements.
+ */
+size_t iter_list_size(const List *list) {
+  if (list->type == LIST_SHARDED)
+    return list->lists.sharded_list->gathered.size;
+  return list_size(list);
+}
+
+ListIter iter_begin(List *list) {
+  ListIter iter = {list, 0, NULL, 0};
+
+  switch (list->type) {
+  case LIST_LINKED_SENTINEL:
+  case LIST_CONCURRENT:
+  case LIST_BOUNDED:
+    // Lands on the sentinel (the end) when the list is empty
+    iter.cursor = list_sentinel_list(list)->head->next;
+    break;
+  case LIST_SHARDED:
+    // Walks the gathered list; appends made meanwhile wait in the shards
+    iter.cursor = sharded_list_lock(list->lists.sharded_list)->head->next;
+    sharded_list_unlock(list->lists.sharded_list);
+    break;
+  case LIST_ARRAY:
+  case LIST_GAP_BUFFER:
+  case LIST_DEQUE_LOCKFREE:
+    break;
+  case LIST_UNROLLED:
+    iter.cursor = list->lists.unrolled_list.head;
+    break;
+  case LIST_SKIP:
+    iter.cursor = list->lists.skip_list.head->links[0].next;
+    break;
+  case LIST_TREE: {
+    TreeNode *node = list->lists.tree_list.root;
+    while (node && node->left)
+      node = node->left;
+    iter.cursor = node;
+    break;
+  }
+  case LIST_MPSC:
+    iter.cursor = mpsc_queue_next(list->lists.mpsc_queue, NULL);
+    break;
+  case LIST_RCU:
+    iter.cursor = rcu_list_next(list->lists.rcu_list->list.head);
+    break;
+  }
+
+  return iter;
+}
+
+ListIter iter_end(List *list) {
+  ListIter iter = {list, iter_list_size(list), NULL, 0};
+
+  switch (list->type) {
+  case LIST_LINKED_SENTINEL:
+  case LIST_CONCURRENT:
+  case LIST_BOUNDED:
+    iter.cursor = list_sentinel_list(list)->head;
+    break;
+  case LIST_SHARDED: {
+    SentinelLinkedList *gathered =
+        sharded_list_lock(list->lists.sharded_list);
+    iter.index = gathered->size;
+    iter.cursor = gathered->head;
+    sharded_list_unlock(list->lists.sharded_list);
+    break;
+  }
+  case LIST_RCU:
+    iter.cursor = list->lists.rcu_list->list.head;
+    break;
+  case LIST_UNROLLED:
+    // End is one past the tail block's last slot
+    iter.cursor = list->lists.unrolled_list.tail;
+    iter.offset = (iter.cursor) ? list->lists.unrolled_list.tail->count : 0;
+    break;
+  case LIST_ARRAY:
+  case LIST_GAP_BUFFER:
+  case LIST_SKIP:
+  case LIST_TREE:
+  case LIST_MPSC:
+  case LIST_DEQUE_LOCKFREE:
+    // End is a NULL cursor (or just the index)
+    break;
+  }
+
+  return iter;
+}
+
+/**
+ * @brief Move a cursor on to the next position without checking it is on an
+ * element (the caller knows it is), so no size lookup is needed. An RCU
+ * cursor stays on the sentinel.
+ * @param iter Pointer to the cursor.
+ */
+void iter_step(ListIter *iter) {
+  iter->index += 1;
+
+  switch (iter->list->type) {
+  case LIST_LINKED_SENTINEL:
+  case LIST_CONCURRENT:
+  case LIST_SHARDED:
+  case LIST_BOUNDED:
+    iter->cursor = ((Node *)iter->cursor)->next;
+    break;
+  case LIST_ARRAY:
+  case LIST_GAP_BUFFER:
+  case LIST_DEQUE_LOCKFREE:
+    break;
+  case LIST_UNROLLED: {
+    UnrolledNode *node = iter->cursor;
+    iter->offset += 1;
+    // Stay one past the tail's last slot at the end
+    if (iter->offset == node->count && node->next) {
+      iter->cursor = node->next;
+      iter->offset = 0;
+    }
+    break;
+  }
+  case LIST_SKIP:
+    iter->cursor = ((SkipNode *)iter->cursor)->links[0].next;
+    break;
+  case LIST_TREE:
+    iter->cursor = tree_node_next(iter->cursor);
+    break;
+  case LIST_MPSC:
+    iter->cursor = mpsc_queue_next(iter->list->lists.mpsc_queue, iter->cursor);
+    break;
+  case LIST_RCU:
+    if (iter->cursor != iter->list->lists.rcu_list->list.head)
+      iter->cursor = rcu_list_next(iter->cursor);
+    break;
+  }
+}
+
+/**
+ * @brief Move a cursor forward several positions, jumping straight there for
+ * the index-only cursors and walking for the others.
+ * @param iter Pointer to the cursor.
+ * @param steps Number of positions (the cursor must not pass the end).
+ */
+void iter_advance(ListIter *iter, size_t steps) {
+  ListType type = iter->list->type;
+  if (type == LIST_ARRAY || type == LIST_GAP_BUFFER ||
+      type == LIST_DEQUE_LOCKFREE) {
+    iter->index += steps;
+    return;
+  }
+  for (size_t i = 0; i < steps; i++)
+    iter_step(iter);
+}
+
+bool iter_next(ListIter *iter) {
+  // RCU readers stop at the sentinel: writers may change the size under them
+  if (iter->list->type == LIST_RCU) {
+    Node *sentinelNode = iter->list->lists.rcu_list->list.head;
+    if (iter->cursor == sentinelNode)
+      return false;
+    iter_step(iter);
+    return iter->cursor != sentinelNode;
+  }
+  if (iter->index >= iter_list_size(iter->list))
+    return false;
+  iter_step(iter);
+  return iter->index < iter_list_size(iter->list);
+}
+
+bool iter_prev(ListIter *iter) {
+  // MPSC nodes only link forward, and RCU readers only follow next pointers
+  if (iter->index == 0 || iter->list->type == LIST_MPSC ||
+      iter->list->type == LIST_RCU)
+    return false;
+  iter->index -= 1;
+
+  switch (iter->list->type) {
   case LIST_LINKED_SENTINEL:
-    list = sentinel_list_create();
+  case LIST_CONCURRENT:
+  case LIST_SHARDED:
+  case LIST_BOUNDED:
+    iter->cursor = ((Node *)iter->cursor)->prev;
+    break;
+  case LIST_ARRAY:
+  case LIST_GAP_BUFFER:
+  case LIST_DEQUE_LOCKFREE:
+    break;
+  case LIST_UNROLLED:
+    if (iter->offset == 0) {
+      iter->cursor = ((UnrolledNode *)iter->cursor)->prev;
+      iter->offset = ((UnrolledNode *)iter->cursor)->count;
+    }
+    iter->offset -= 1;
+    break;
+  case LIST_SKIP:
+    // No node to step back from at the end
+    iter->cursor = (iter->cursor)
+                       ? ((SkipNode *)iter->cursor)->prev
+                       : skip_list_find(&iter->list->lists.skip_list,
+                                        iter->index);
+    break;
+  case LIST_TREE:
+    if (iter->cursor) {
+      iter->cursor = tree_node_prev(iter->cursor);
+    } else {
+      TreeNode *node = iter->list->lists.tree_list.root;
+      while (node->right)
+        node = node->right;
+      iter->cursor = node;
+    }
+    break;
+  case LIST_MPSC: // rejected above
+  case LIST_RCU:  // rejected above
     break;
   }
 
-  return list;
+  return true;
 }
 
-void list_destroy(List *list, FreeFunc free_func) {
-  switch (list->type) {
+/**
+ * @brief Get the element under a cursor without checking it is on one (the
+ * caller knows it is), so no size lookup is needed. NULL for an RCU cursor
+ * on the sentinel.
+ * @param iter Pointer to the cursor.
+ * @return Pointer to the element.
+ */
+void *iter_value(const ListIter *iter) {
+  switch (iter->list->type) {
   case LIST_LINKED_SENTINEL:
-    sentinel_list_destroy(list, free_func);
+  case LIST_CONCURRENT:
+  case LIST_SHARDED:
+  case LIST_BOUNDED:
+    return iter->cursor;
+  case LIST_ARRAY:
+    return array_list_get(&iter->list->lists.array_list, iter->index);
+  case LIST_GAP_BUFFER:
+    return gap_list_get(&iter->list->lists.gap_list, iter->index);
+  case LIST_UNROLLED:
+    return ((UnrolledNode *)iter->cursor)->items[iter->offset];
+  case LIST_SKIP:
+    return ((SkipNode *)iter->cursor)->data;
+  case LIST_TREE:
+    return ((TreeNode *)iter->cursor)->data;
+  case LIST_MPSC:
+    // NULL while the node at the cursor is still being linked
+    return iter->cursor;
+  case LIST_DEQUE_LOCKFREE:
+    return lockfree_deque_get(iter->list->lists.lockfree_deque, iter->index);
+  case LIST_RCU: {
+    Node *sentinelNode = iter->list->lists.rcu_list->list.head;
+    return (iter->cursor != sentinelNode) ? iter->cursor : NULL;
+  }
+  }
+  return NULL; // GCOVR_EXCL_LINE
+}
+
+/**
+ * @brief Replace the element under a cursor of a type that stores element
+ * pointers (node-based types, whose elements are the nodes, are left alone).
+ * @param iter Pointer to the cursor (on an element).
+ * @param data The new element.
+ */
+void iter_store(ListIter *iter, void *data) {
+  switch (iter->list->type) {
+  case LIST_ARRAY:
+    iter->list->lists.array_list.items[iter->index] = data;
+    break;
+  case LIST_GAP_BUFFER: {
+    GapBufferList *gap_list = &iter->list->lists.gap_list;
+    size_t slot = (iter->index < gap_list->gap_start)
+                      ? iter->index
+                      : iter->index + gap_list->gap_end - gap_list->gap_start;
+    gap_list->items[slot] = data;
+    break;
+  }
+  case LIST_UNROLLED:
+    ((UnrolledNode *)iter->cursor)->items[iter->offset] = data;
+    break;
+  case LIST_SKIP:
+    ((SkipNode *)iter->cursor)->data = data;
+    break;
+  case LIST_TREE:
+    ((TreeNode *)iter->cursor)->data = data;
+    break;
+  case LIST_LINKED_SENTINEL:
+  case LIST_CONCURRENT:
+  case LIST_MPSC:
+  case LIST_DEQUE_LOCKFREE:
+  case LIST_RCU:
+  case LIST_SHARDED:
+  case LIST_BOUNDED:
+    // The elements are the nodes (or owned by other threads)
     break;
   }
+}
 
-  // AI Use: Assisted by AI
-  // Used to find how to skip brackets marked as "untested" line
-  // NOTE: tests for brackets with no code behind it
+void *iter_get(const ListIter *iter) {
+  // RCU cursors end at the sentinel, not at a size writers may change
+  if (iter->list->type != LIST_RCU &&
+      iter->index >= iter_list_size(iter->list))
+    return NULL;
+  return iter_value(iter);
+}
 
-} // GCOVR_EXCL_LINE
+bool iter_insert(ListIter *iter, void *data) {
+  List *list = iter->list;
+  bool inserted = false;
 
-bool list_append(List *list, void *data) {
-  Node *dataNode = data;
   switch (list->type) {
-  case LIST_LINKED_SENTINEL:
+  case LIST_LINKED_SENTINEL: {
+    Node *dataNode = data;
     // Check a node was passed in as data
-    // GCOVR_EXCL_START
-    if (dataNode->type != SENTINEL && dataNode->type != NODE)
+    if (!dataNode || (dataNode->type != SENTINEL && dataNode->type != NODE))
       return false;
-    // GCOVR_EXCL_STOP
-    return sentinel_list_append(list->lists.sentinel_list, data);
+    sentinel_list_link_before(&list->lists.sentinel_list, iter->cursor,
+                              iter->index, dataNode);
+    inserted = true;
+    break;
+  }
+  case LIST_CONCURRENT: {
+    Node *dataNode = data;
+    if (!dataNode || (dataNode->type != SENTINEL && dataNode->type != NODE))
+      return false;
+    ConcurrentList *concurrent_list = list->lists.concurrent_list;
+    pthread_rwlock_wrlock(&concurrent_list->lock);
+    sentinel_list_link_before(&concurrent_list->list, iter->cursor,
+                              iter->index, dataNode);
+    pthread_rwlock_unlock(&concurrent_list->lock);
+    inserted = true;
+    break;
+  }
+  case LIST_SHARDED: {
+    Node *dataNode = data;
+    if (!dataNode || (dataNode->type != SENTINEL && dataNode->type != NODE))
+      return false;
+    // No gathering: that could move the end out from under the cursor
+    ShardedList *sharded_list = list->lists.sharded_list;
+    pthread_mutex_lock(&sharded_list->lock);
+    sentinel_list_link_before(&sharded_list->gathered, iter->cursor,
+                              iter->index, dataNode);
+    sharded_list_unlock(sharded_list);
+    inserted = true;
+    break;
+  }
+  case LIST_BOUNDED: {
+    Node *dataNode = data;
+    if (!dataNode || (dataNode->type != SENTINEL && dataNode->type != NODE))
+      return false;
+    BoundedQueue *queue = list->lists.bounded_queue;
+    pthread_mutex_lock(&queue->lock);
+    inserted = !queue->closed && queue->list.size < queue->capacity;
+    if (inserted) {
+      sentinel_list_link_before(&queue->list, iter->cursor, iter->index,
+                                dataNode);
+      bounded_queue_wake_consumers(queue, 1);
+    }
+    pthread_mutex_unlock(&queue->lock);
+    break;
+  }
+  case LIST_ARRAY:
+    inserted = array_list_insert(&list->lists.array_list, iter->index, data);
+    break;
+  case LIST_GAP_BUFFER:
+    // The gap follows the cursor, so runs of edits here are O(1)
+    inserted = gap_list_insert(&list->lists.gap_list, iter->index, data);
+    break;
+  case LIST_UNROLLED: {
+    if (!data)
+      return false;
+    UnrolledNode *node = unrolled_list_insert_at(
+        &list->lists.unrolled_list, iter->cursor, &iter->offset, data);
+    if (!node)
+      return false;
+    // Step over the new element back onto the one the cursor was on
+    iter->cursor = node;
+    iter->offset += 1;
+    if (iter->offset == node->count && node->next) {
+      iter->cursor = node->next;
+      iter->offset = 0;
+    }
+    inserted = true;
+    break;
+  }
+  case LIST_SKIP:
+    // Nodes never move, so the cursor stays valid
+    inserted = skip_list_insert(&list->lists.skip_list, iter->index, data);
+    break;
+  case LIST_TREE:
+    // Rotations relink nodes without moving data, so the cursor stays valid
+    inserted = tree_list_insert(&list->lists.tree_list, iter->index, data);
+    break;
+  case LIST_MPSC:
+    // Producers only append
+    return false;
+  case LIST_RCU:
+    // Cursors are for readers; another writer may have unlinked the node
+    return false;
+  case LIST_DEQUE_LOCKFREE:
+    // Only at the end (the back)
+    inserted = list_insert(list, iter->index, data);
+    break;
   }
-} // GCOVR_EXCL_LINE
 
-bool list_insert(List *list, size_t index, void *data) {
-  Node *dataNode = data;
+  if (inserted)
+    iter->index += 1;
+  return inserted;
+}
+
+void *iter_remove(ListIter *iter) {
+  List *list = iter->list;
+  if (iter->index >= iter_list_size(list))
+    return NULL;
+
   switch (list->type) {
-  case LIST_LINKED_SENTINEL:
-    // Check a node was passed in as data
-    // GCOVR_EXCL_START
-    if (dataNode->type != SENTINEL && dataNode->type != NODE)
-      return false;
-    // GCOVR_EXCL_STOP
+  case LIST_LINKED_SENTINEL: {
+    Node *node = iter->cursor;
+    iter->cursor = node->next;
+    sentinel_list_unlink(&list->lists.sentinel_list, node, iter->index);
+    return node;
+  }
+  case LIST_CONCURRENT: {
+    ConcurrentList *concurrent_list = list->lists.concurrent_list;
+    Node *node = iter->cursor;
+    iter->cursor = node->next;
+    pthread_rwlock_wrlock(&concurrent_list->lock);
+    sentinel_list_unlink(&concurrent_list->list, node, iter->index);
+    pthread_rwlock_unlock(&concurrent_list->lock);
+    return node;
+  }
+  case LIST_SHARDED: {
+    ShardedList *sharded_list = list->lists.sharded_list;
+    Node *node = iter->cursor;
+    iter->cursor = node->next;
+    pthread_mutex_lock(&sharded_list->lock);
+    sentinel_list_unlink(&sharded_list->gathered, node, iter->index);
+    sharded_list_unlock(sharded_list);
+    return node;
+  }
+  case LIST_BOUNDED: {
+    BoundedQueue *queue = list->lists.bounded_queue;
+    Node *node = iter->cursor;
+    iter->cursor = node->next;
+    pthread_mutex_lock(&queue->lock);
+    sentinel_list_unlink(&queue->list, node, iter->index);
+    bounded_queue_wake_producers(queue, 1);
+    pthread_mutex_unlock(&queue->lock);
+    return node;
+  }
+  case LIST_ARRAY:
+    return array_list_remove(&list->lists.array_list, iter->index);
+  case LIST_GAP_BUFFER:
+    return gap_list_remove(&list->lists.gap_list, iter->index);
+  case LIST_UNROLLED: {
+    UnrolledNode *node = iter->cursor;
+    void *data = unrolled_list_remove_at(&list->lists.unrolled_list, &node,
+                                         &iter->offset);
+    iter->cursor = node;
+    return data;
+  }
+  case LIST_SKIP:
+    iter->cursor = ((SkipNode *)iter->cursor)->links[0].next;
+    return skip_list_remove(&list->lists.skip_list, iter->index);
+  case LIST_TREE:
+    iter->cursor = tree_node_next(iter->cursor);
+    return tree_list_remove(&list->lists.tree_list, iter->index);
+  case LIST_MPSC: {
+    // The consumer only pops the front
+    if (iter->index != 0 || !iter->cursor)
+      return NULL;
+    MpscQueue *queue = list->lists.mpsc_queue;
+    Node *next = mpsc_queue_next(queue, iter->cursor);
+    Node *node = mpsc_queue_pop(queue);
+    if (node)
+      iter->cursor = next;
+    return node;
+  }
+  case LIST_DEQUE_LOCKFREE:
+    // Only at the two ends
+    return list_remove(list, iter->index);
+  case LIST_RCU:
+    // Cursors are for readers; edit through list_remove
+    return NULL;
+  }
+  return NULL; // GCOVR_EXCL_LINE
+}
 
-    // Insert node into list
-    return sentinel_list_insert(list->lists.sentinel_list, index, dataNode);
+/*
+ * ========
+ * PARALLEL
+ * ========
+ */
+
+// Ranges smaller than this cost more to hand out than to run
+#define LIST_PARALLEL_MIN_RANGE 1024
+
+static ListPool list_pool = {PTHREAD_MUTEX_INITIALIZER,
+                             PTHREAD_COND_INITIALIZER,
+                             PTHREAD_COND_INITIALIZER,
+                             PTHREAD_MUTEX_INITIALIZER,
+                             NULL,
+                             0,
+                             0};
+
+// Set while a thread runs pool tasks, so a nested parallel call runs inline
+// rather than wait for the pool it is part of
+static _Thread_local bool list_pool_busy = false;
+
+/**
+ * @brief Claim and run tasks of a job until none are left.
+ * @param job Pointer to the job.
+ */
+void list_pool_run_tasks(ListPoolJob *job) {
+  size_t task = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED);
+  while (task < job->count) {
+    job->run(job->arg, task);
+    task = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED);
   }
-} // GCOVR_EXCL_LINE
+}
 
-void *list_remove(List *list, size_t index) {
-  switch (list->type) {
-  case LIST_LINKED_SENTINEL:
-    return sentinel_list_remove(list->lists.sentinel_list, index);
+/**
+ * @brief Body of a pool worker: join every job published after it started,
+ * for as long as the process runs.
+ * @param arg Unused.
+ * @return Never returns.
+ */
+void *list_pool_worker(void *arg) {
+  (void)arg;
+  list_pool_busy = true;
+  uint64_t seen = 0;
+  pthread_mutex_lock(&list_pool.lock);
+  for (;;) {
+    while (!list_pool.job || list_pool.generation == seen)
+      pthread_cond_wait(&list_pool.wake, &list_pool.lock);
+    seen = list_pool.generation;
+    ListPoolJob *job = list_pool.job;
+    job->active += 1;
+    pthread_mutex_unlock(&list_pool.lock);
+
+    list_pool_run_tasks(job);
+
+    pthread_mutex_lock(&list_pool.lock);
+    job->active -= 1;
+    if (job->active == 0)
+      pthread_cond_signal(&list_pool.done);
   }
-} // GCOVR_EXCL_LINE
+}
 
-void *list_get(const List *list, size_t index) {
-  switch (list->type) {
-  case LIST_LINKED_SENTINEL:
-    return sentinel_list_get(list->lists.sentinel_list, index);
+/**
+ * @brief Run `count` tasks on the pool and the calling thread, returning once
+ * all of them are done. Workers are started on demand (at most one per task
+ * beyond the caller's own); if none can be, the caller runs every task.
+ * @param run Function run once per task number.
+ * @param arg Argument passed to every call of `run`.
+ * @param count Number of tasks.
+ */
+void list_pool_run(void (*run)(void *arg, size_t task), void *arg,
+                   size_t count) {
+  ListPoolJob job = {run, arg, count, 0, 0};
+  if (count < 2 || list_pool_busy) {
+    list_pool_run_tasks(&job);
+    return;
   }
-} // GCOVR_EXCL_LINE
 
-size_t list_size(const List *list) {
-  switch (list->type) {
-  case LIST_LINKED_SENTINEL:
-    return sentinel_list_size(list->lists.sentinel_list);
+  pthread_mutex_lock(&list_pool.job_lock);
+  pthread_mutex_lock(&list_pool.lock);
+  while (list_pool.threads < count - 1 &&
+         list_pool.threads < LIST_POOL_MAX_THREADS) {
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, list_pool_worker, NULL) != 0)
+      break; // GCOVR_EXCL_LINE
+    pthread_detach(thread);
+    list_pool.threads += 1;
   }
-} // GCOVR_EXCL_LINE
+  list_pool.job = &job;
+  list_pool.generation += 1;
+  // Wake only as many workers as there are tasks to share
+  for (size_t i = 1; i < count; i++)
+    pthread_cond_signal(&list_pool.wake);
+  pthread_mutex_unlock(&list_pool.lock);
 
-bool list_is_empty(const List *list) {
+  list_pool_busy = true;
+  list_pool_run_tasks(&job);
+  list_pool_busy = false;
+
+  // Every task is claimed; wait out the workers still running theirs, and
+  // unpublish the job so no late worker picks it up
+  pthread_mutex_lock(&list_pool.lock);
+  list_pool.job = NULL;
+  while (job.active > 0)
+    pthread_cond_wait(&list_pool.done, &list_pool.lock);
+  pthread_mutex_unlock(&list_pool.lock);
+  pthread_mutex_unlock(&list_pool.job_lock);
+}
+
+/**
+ * @brief Get the number of threads to use for a parallel call.
+ * @param nthreads Requested threads, or 0 for one per online CPU.
+ * @return The number of threads, at most one more than the pool holds.
+ */
+size_t list_parallel_threads(size_t nthreads) {
+  if (nthreads == 0) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    nthreads = (cpus > 0) ? (size_t)cpus : 1;
+  }
+  return (nthreads > LIST_POOL_MAX_THREADS + 1) ? LIST_POOL_MAX_THREADS + 1
+                                                : nthreads;
+}
+
+/**
+ * @struct ListRange
+ * @brief a contiguous run of elements: a cursor on the first and the count.
+ */
+typedef struct ListRange {
+  ListIter first;
+  size_t count;
+} ListRange;
+
+/**
+ * @struct ListForEachJob
+ * @brief what every range of a list_parallel_for_each call shares.
+ */
+typedef struct ListForEachJob {
+  ListVisitFunc fn;
+  void *ctx;
+  ListRange *ranges;
+} ListForEachJob;
+
+/**
+ * @brief Call the function on every element of one range (a pool task).
+ * @param arg Pointer to the ListForEachJob.
+ * @param task Index of the range.
+ */
+void list_for_each_range(void *arg, size_t task) {
+  ListForEachJob *job = arg;
+  ListIter iter = job->ranges[task].first;
+  for (size_t i = 0; i < job->ranges[task].count; i++) {
+    void *data = iter_value(&iter);
+    // An RCU list may have shrunk since it was partitioned
+    if (!data && iter.list->type == LIST_RCU)
+      break;
+    job->fn(data, iter.index, job->ctx);
+    iter_step(&iter);
+  }
+}
+
+void list_parallel_for_each(List *list, ListVisitFunc fn, void *ctx,
+                            size_t nthreads) {
+  nthreads = list_parallel_threads(nthreads);
+  // Nodes reached inside the read-side section stay valid until its end
+  size_t token = list_rcu_read_lock(list);
+
+  ListIter iter = iter_begin(list);
+  size_t size = iter_list_size(list);
+  size_t count = (size + LIST_PARALLEL_MIN_RANGE - 1) / LIST_PARALLEL_MIN_RANGE;
+  if (count > nthreads)
+    count = nthreads;
+
+  // One walk places the first cursor of every range
+  ListRange ranges[LIST_POOL_MAX_THREADS + 1];
+  size_t start = 0;
+  for (size_t i = 0; i < count; i++) {
+    size_t end = size / count * (i + 1) + size % count * (i + 1) / count;
+    ranges[i].first = iter;
+    ranges[i].count = end - start;
+    if (i + 1 < count)
+      iter_advance(&iter, end - start);
+    start = end;
+  }
+
+  ListForEachJob job = {fn, ctx, ranges};
+  list_pool_run(list_for_each_range, &job, count);
+  list_rcu_read_unlock(list, token);
+}
+
+/*
+ * =======
+ * SORTING
+ * =======
+ */
+
+// Runs this short are insertion sorted before merging starts
+#define LIST_SORT_RUN 16
+
+/**
+ * @brief Merge two sorted runs of element pointers into `dst`. Ties take the
+ * element from `first`, so merging an earlier run with a later one is stable.
+ * @param dst Destination (room for both runs, not overlapping them).
+ * @param first Run of the earlier elements.
+ * @param first_count Number of elements in `first`.
+ * @param second Run of the later elements.
+ * @param second_count Number of elements in `second`.
+ * @param cmp Comparison function.
+ */
+void list_merge_items(void **dst, void **first, size_t first_count,
+                      void **second, size_t second_count,
+                      ListCompareFunc cmp) {
+  size_t i = 0, j = 0;
+  while (i < first_count && j < second_count) {
+    if (cmp(second[j], first[i]) < 0)
+      *dst++ = second[j++];
+    else
+      *dst++ = first[i++];
+  }
+  memcpy(dst, &first[i], (first_count - i) * sizeof(void *));
+  memcpy(dst + (first_count - i), &second[j],
+         (second_count - j) * sizeof(void *));
+}
+
+/**
+ * @brief Stable bottom-up merge sort of element pointers: short runs are
+ * insertion sorted, then merged back and forth between the two buffers.
+ * @param items Elements to sort (sorted in place).
+ * @param scratch Scratch buffer of the same length.
+ * @param count Number of elements.
+ * @param cmp Comparison function.
+ */
+void list_sort_items(void **items, void **scratch, size_t count,
+                     ListCompareFunc cmp) {
+  for (size_t start = 0; start < count; start += LIST_SORT_RUN) {
+    size_t end =
+        (count - start < LIST_SORT_RUN) ? count : start + LIST_SORT_RUN;
+    for (size_t i = start + 1; i < end; i++) {
+      void *item = items[i];
+      size_t j = i;
+      // Only strictly greater elements move past it
+      for (; j > start && cmp(item, items[j - 1]) < 0; j--)
+        items[j] = items[j - 1];
+      items[j] = item;
+    }
+  }
+
+  void **src = items, **dst = scratch;
+  for (size_t width = LIST_SORT_RUN; width < count; width *= 2) {
+    for (size_t start = 0; start < count; start += 2 * width) {
+      size_t mid = (count - start < width) ? count : start + width;
+      size_t end = (count - mid < width) ? count : mid + width;
+      list_merge_items(&dst[start], &src[start], mid - start, &src[mid],
+                       end - mid, cmp);
+    }
+    void **swap = src;
+    src = dst;
+    dst = swap;
+  }
+  if (src != items)
+    memcpy(items, src, count * sizeof(void *));
+}
+
+/**
+ * @struct ListSortJob
+ * @brief state shared by the tasks of a parallel sort: the runs (chains of
+ * nodes, or slices of an element buffer between `bounds`) and the current
+ * merge round.
+ */
+typedef struct ListSortJob {
+  ListCompareFunc cmp;
+  size_t runs;
+  size_t width;  // merge round: run i merges with run i + width
+  Node **chains;     // node-based types: one chain per run
+  void **src, **dst; // element buffers: this round reads src, writes dst
+  size_t *bounds;    // element buffers: run i is [bounds[i], bounds[i + 1])
+} ListSortJob;
+
+/**
+ * @brief Sort one run of a parallel sort (a pool task).
+ * @param arg Pointer to the ListSortJob.
+ * @param task Index of the run.
+ */
+void list_sort_run(void *arg, size_t task) {
+  ListSortJob *job = arg;
+  if (job->chains) {
+    job->chains[task] = sentinel_chain_sort(job->chains[task], job->cmp);
+    return;
+  }
+  size_t start = job->bounds[task];
+  list_sort_items(&job->src[start], &job->dst[start],
+                  job->bounds[task + 1] - start, job->cmp);
+}
+
+/**
+ * @brief Merge one pair of neighbouring runs of a merge round (a pool task):
+ * run 2 * task * width takes in the run `width` after it, if there is one.
+ * @param arg Pointer to the ListSortJob.
+ * @param task Index of the pair.
+ */
+void list_sort_merge(void *arg, size_t task) {
+  ListSortJob *job = arg;
+  size_t first = 2 * task * job->width;
+  size_t second = first + job->width;
+  if (job->chains) {
+    if (second < job->runs)
+      job->chains[first] = sentinel_chain_merge(
+          job->chains[first], job->chains[second], job->cmp);
+    return;
+  }
+  size_t end = (second + job->width < job->runs) ? second + job->width
+                                                 : job->runs;
+  if (second > job->runs)
+    second = job->runs;
+  size_t start = job->bounds[first], mid = job->bounds[second];
+  list_merge_items(&job->dst[start], &job->src[start], mid - start,
+                   &job->src[mid], job->bounds[end] - mid, job->cmp);
+}
+
+/**
+ * @brief Merge the sorted runs of a job pairwise, one parallel round per
+ * doubling of the run width, until run 0 holds everything. Element buffers
+ * swap roles every round.
+ * @param job Pointer to the job.
+ */
+void list_sort_merge_rounds(ListSortJob *job) {
+  for (job->width = 1; job->width < job->runs; job->width *= 2) {
+    size_t pairs = (job->runs + 2 * job->width - 1) / (2 * job->width);
+    list_pool_run(list_sort_merge, job, pairs);
+    void **swap = job->src;
+    job->src = job->dst;
+    job->dst = swap;
+  }
+}
+
+/**
+ * @brief Get how many runs to split a sort of `size` elements into.
+ * @param size Number of elements.
+ * @param nthreads Threads to use.
+ * @return The number of runs (1 sorts on the calling thread alone).
+ */
+size_t list_sort_runs(size_t size, size_t nthreads) {
+  size_t runs = size / LIST_PARALLEL_MIN_RANGE;
+  if (runs > nthreads)
+    runs = nthreads;
+  return (runs > 0) ? runs : 1;
+}
+
+/**
+ * @brief Sort a sentinel list by relinking its nodes, splitting it into runs
+ * sorted and merged on the pool (no allocation either way).
+ * @param sentinel_list Pointer to the sentinel list.
+ * @param cmp Comparison function.
+ * @param nthreads Threads to use.
+ */
+void sentinel_list_sort_parallel(SentinelLinkedList *sentinel_list,
+                                 ListCompareFunc cmp, size_t nthreads) {
+  size_t size = sentinel_list->size;
+  size_t runs = list_sort_runs(size, nthreads);
+  if (runs < 2) {
+    sentinel_list_sort(sentinel_list, cmp);
+    return;
+  }
+
+  // One walk cuts the ring into runs
+  Node *chains[LIST_POOL_MAX_THREADS + 1];
+  Node *node = sentinel_list->head->next;
+  sentinel_list->tail->next = NULL;
+  for (size_t i = 0; i < runs; i++) {
+    size_t length = size / runs + (i < size % runs);
+    chains[i] = node;
+    for (size_t j = 1; j < length; j++)
+      node = node->next;
+    Node *last = node;
+    node = node->next;
+    last->next = NULL;
+  }
+
+  ListSortJob job = {cmp, runs, 0, chains, NULL, NULL, NULL};
+  list_pool_run(list_sort_run, &job, runs);
+  list_sort_merge_rounds(&job);
+  sentinel_list_relink(sentinel_list, chains[0]);
+}
+
+/**
+ * @brief Sort the element pointers of a list that stores them (rather than
+ * being made of the elements): LIST_ARRAY in its own buffer, the others
+ * gathered into one and stored back in order.
+ * @param list Pointer to the list.
+ * @param cmp Comparison function.
+ * @param nthreads Threads to use.
+ * @return true on success, false if the scratch buffer couldn't be allocated.
+ */
+bool list_sort_values(List *list, ListCompareFunc cmp, size_t nthreads) {
+  size_t size = list_size(list);
+  if (size < 2)
+    return true;
+  bool in_place = list->type == LIST_ARRAY;
+  void **buffer = list_mem_alloc(&list->allocator,
+                                 (in_place ? 1 : 2) * size * sizeof(void *));
+  if (!buffer)
+    return false;
+  void **items = (in_place) ? list->lists.array_list.items : buffer;
+  void **scratch = (in_place) ? buffer : buffer + size;
+
+  ListIter iter = iter_begin(list);
+  if (!in_place) {
+    for (size_t i = 0; i < size; i++, iter_step(&iter))
+      items[i] = iter_value(&iter);
+  }
+
+  size_t runs = list_sort_runs(size, nthreads);
+  if (runs < 2) {
+    list_sort_items(items, scratch, size, cmp);
+  } else {
+    size_t bounds[LIST_POOL_MAX_THREADS + 2];
+    for (size_t i = 0; i <= runs; i++)
+      bounds[i] = size / runs * i + size % runs * i / runs;
+    ListSortJob job = {cmp, runs, 0, NULL, items, scratch, bounds};
+    list_pool_run(list_sort_run, &job, runs);
+    list_sort_merge_rounds(&job);
+    if (job.src != items)
+      memcpy(items, job.src, size * sizeof(void *));
+  }
+
+  if (!in_place) {
+    iter = iter_begin(list);
+    for (size_t i = 0; i < size; i++, iter_step(&iter))
+      iter_store(&iter, items[i]);
+  }
+  list_mem_free(&list->allocator, buffer);
+  return true;
+}
+
+/**
+ * @brief Lock a sentinel-based list for a sort (gathering a sharded one) and
+ * get the sentinel list to sort.
+ * @param list Pointer to the list.
+ * @return Pointer to the sentinel list, or NULL (and nothing locked) if the
+ * list is not sentinel-based.
+ */
+SentinelLinkedList *list_sort_lock(List *list) {
   switch (list->type) {
   case LIST_LINKED_SENTINEL:
-    return sentinel_list_size(list->lists.sentinel_list) == 0;
+    return &list->lists.sentinel_list;
+  case LIST_CONCURRENT:
+    pthread_rwlock_wrlock(&list->lists.concurrent_list->lock);
+    return &list->lists.concurrent_list->list;
+  case LIST_SHARDED:
+    // Appends made meanwhile wait in the shards, after the sorted elements
+    return sharded_list_lock(list->lists.sharded_list);
+  case LIST_BOUNDED:
+    pthread_mutex_lock(&list->lists.bounded_queue->lock);
+    return &list->lists.bounded_queue->list;
+  case LIST_ARRAY:
+  case LIST_GAP_BUFFER:
+  case LIST_UNROLLED:
+  case LIST_SKIP:
+  case LIST_TREE:
+  case LIST_MPSC:
+  case LIST_DEQUE_LOCKFREE:
+  case LIST_RCU:
+    return NULL;
   }
-} // GCOVR_EXCL_LINE
+  return NULL; // GCOVR_EXCL_LINE
+}
+
+/**
+ * @brief Unlock a list locked by list_sort_lock.
+ * @param list Pointer to the list.
+ */
+void list_sort_unlock(List *list) {
+  if (list->type == LIST_CONCURRENT)
+    pthread_rwlock_unlock(&list->lists.concurrent_list->lock);
+  else if (list->type == LIST_SHARDED)
+    sharded_list_unlock(list->lists.sharded_list);
+  else if (list->type == LIST_BOUNDED)
+    pthread_mutex_unlock(&list->lists.bounded_queue->lock);
+}
+
+/**
+ * @brief Check whether a list can be sorted.
+ * @param list Pointer to the list.
+ * @return false for the types other threads push to, steal from or read
+ * without taking a lock.
+ */
+bool list_sortable(const List *list) {
+  return list->type != LIST_MPSC && list->type != LIST_DEQUE_LOCKFREE &&
+         list->type != LIST_RCU;
+}
+
+bool list_sort_parallel(List *list, ListCompareFunc cmp, size_t nthreads) {
+  if (!list_sortable(list))
+    return false;
+  nthreads = list_parallel_threads(nthreads);
+
+  SentinelLinkedList *sentinel_list = list_sort_lock(list);
+  if (!sentinel_list)
+    return list_sort_values(list, cmp, nthreads);
+  sentinel_list_sort_parallel(sentinel_list, cmp, nthreads);
+  list_sort_unlock(list);
+  return true;
+}
+
+bool list_sort(List *list, ListCompareFunc cmp) {
+  return list_sort_parallel(list, cmp, 1);
+}
+
+// Key bits sorted by each radix pass (8 passes cover a 64-bit key)
+#define LIST_RADIX_BITS 8
+#define LIST_RADIX_BUCKETS (1 << LIST_RADIX_BITS)
+#define LIST_RADIX_PASSES (64 / LIST_RADIX_BITS)
+
+/**
+ * @struct ListKeyed
+ * @brief an element next to its extracted sort key, so radix passes never
+ * call back into the key function or touch the element.
+ */
+typedef struct ListKeyed {
+  uint64_t key;
+  void *item;
+} ListKeyed;
+
+/**
+ * @brief Stable LSD radix sort of keyed elements, one byte of the key per
+ * pass. Every pass's histogram is counted in one read up front, and passes on
+ * a byte all keys share are skipped.
+ * @param keyed Elements to sort.
+ * @param scratch Scratch buffer of the same length.
+ * @param count Number of elements (at least 1).
+ * @return Whichever of the two buffers holds the sorted elements.
+ */
+ListKeyed *list_radix_sort(ListKeyed *keyed, ListKeyed *scratch,
+                           size_t count) {
+  size_t counts[LIST_RADIX_PASSES][LIST_RADIX_BUCKETS];
+  memset(counts, 0, sizeof(counts));
+  for (size_t i = 0; i < count; i++) {
+    for (size_t pass = 0; pass < LIST_RADIX_PASSES; pass++)
+      counts[pass][(keyed[i].key >> (pass * LIST_RADIX_BITS)) &
+                   (LIST_RADIX_BUCKETS - 1)] += 1;
+  }
+
+  ListKeyed *src = keyed, *dst = scratch;
+  for (size_t pass = 0; pass < LIST_RADIX_PASSES; pass++) {
+    unsigned shift = (unsigned)(pass * LIST_RADIX_BITS);
+    size_t *buckets = counts[pass];
+    if (buckets[(src[0].key >> shift) & (LIST_RADIX_BUCKETS - 1)] == count)
+      continue;
+
+    // Turn the counts into each bucket's first slot
+    size_t offset = 0;
+    for (size_t bucket = 0; bucket < LIST_RADIX_BUCKETS; bucket++) {
+      size_t bucket_count = buckets[bucket];
+      buckets[bucket] = offset;
+      offset += bucket_count;
+    }
+    for (size_t i = 0; i < count; i++)
+      dst[buckets[(src[i].key >> shift) & (LIST_RADIX_BUCKETS - 1)]++] =
+          src[i];
+    ListKeyed *swap = src;
+    src = dst;
+    dst = swap;
+  }
+  return src;
+}
+
+bool list_sort_by_key(List *list, ListKeyFunc key_fn) {
+  if (!list_sortable(list))
+    return false;
+
+  SentinelLinkedList *sentinel_list = list_sort_lock(list);
+  size_t size = (sentinel_list) ? sentinel_list->size : list_size(list);
+  ListKeyed *keyed = NULL;
+  if (size >= 2)
+    keyed = list_mem_alloc(&list->allocator, 2 * size * sizeof(ListKeyed));
+  if (!keyed) {
+    list_sort_unlock(list);
+    return size < 2; // nothing to sort, or no scratch buffer
+  }
+
+  // Each key is extracted once
+  if (sentinel_list) {
+    Node *node = sentinel_list->head->next;
+    for (size_t i = 0; i < size; i++, node = node->next)
+      keyed[i] = (ListKeyed){key_fn(node), node};
+  } else {
+    ListIter iter = iter_begin(list);
+    for (size_t i = 0; i < size; i++, iter_step(&iter)) {
+      void *data = iter_value(&iter);
+      keyed[i] = (ListKeyed){key_fn(data), data};
+    }
+  }
+
+  ListKeyed *sorted = list_radix_sort(keyed, keyed + size, size);
+
+  if (sentinel_list) {
+    // Relink the ring in one pass over the sorted nodes
+    Node *prev = sentinel_list->head;
+    for (size_t i = 0; i < size; i++) {
+      Node *node = sorted[i].item;
+      prev->next = node;
+      node->prev = prev;
+      prev = node;
+    }
+    sentinel_list_close(sentinel_list, prev);
+  } else {
+    ListIter iter = iter_begin(list);
+    for (size_t i = 0; i < size; i++, iter_step(&iter))
+      iter_store(&iter, sorted[i].item);
+  }
+  list_sort_unlock(list);
+  list_mem_free(&list->allocator, keyed);
+  return true;
+}
@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 /**
  * @file lab.h
@@ -15,7 +16,43 @@ typedef struct List List;
  * @enum ListType
  * @brief Enumeration for selecting the list implementation type.
  */
-typedef enum { LIST_LINKED_SENTINEL } ListType;
+typedef enum {
+  LIST_LINKED_SENTINEL, ///< circular doubly linked list of caller nodes
+  LIST_ARRAY,           ///< contiguous growable buffer, O(1) list_get
+  LIST_GAP_BUFFER,      ///< buffer with a gap at the last edit position
+  LIST_UNROLLED,        ///< linked cache-line blocks of several elements
+  LIST_SKIP,            ///< indexable skip list, expected O(log n) access
+  LIST_TREE,            ///< order-statistic AVL tree, O(log n) access
+  LIST_CONCURRENT,      ///< sentinel list behind a reader-writer lock
+  LIST_MPSC,            ///< lock-free multi-producer single-consumer queue
+  LIST_DEQUE_LOCKFREE,  ///< lock-free work-stealing deque (Chase-Lev)
+  LIST_RCU,             ///< read-copy-update list for read-mostly sharing
+  LIST_SHARDED,         ///< sentinel list with per-thread append shards
+  LIST_BOUNDED          ///< blocking producer/consumer queue with a capacity
+} ListType;
+
+/*
+ * Threading rules of the shared types (see also list_create_sharded,
+ * list_create_bounded and list_rcu_read_lock):
+ *
+ * LIST_CONCURRENT: list_get and list_size run in parallel, edits are
+ * exclusive. Iterating is not synchronized against other threads' edits, and
+ * there is no node pool.
+ *
+ * LIST_MPSC: any thread may list_append/list_append_many; one consumer thread
+ * at a time may list_remove(list, 0), list_get, list_clear and iterate
+ * forward. Other positions are not supported. list_size counts appends still
+ * being linked, so list_remove(list, 0) can briefly return NULL.
+ *
+ * LIST_DEQUE_LOCKFREE: one owner thread pushes and pops at the back; any
+ * thread may steal from the front with list_pop_front. Pushing at the front,
+ * positional edits, splice and split are not supported, and list_get and
+ * iteration are for the owner.
+ *
+ * LIST_RCU: readers take no lock, and list_remove only returns once no
+ * reader can still see the node, so it may be freed right away. Iteration is
+ * forward-only and read-only, and splice and split are not supported.
+ */
 
 /**
  * @typedef FreeFunc
@@ -33,6 +70,122 @@ typedef void (*FreeFunc)(void *);
  */
 List *list_create(ListType type);
 
+/**
+ * @brief Create a new LIST_SHARDED list with a chosen number of shards
+ * (list_create uses one per online CPU, unordered). Appends go to the
+ * calling thread's shard under its own lock; every other operation first
+ * gathers the shards under a list-wide lock. list_size takes no lock, and
+ * iterating is not synchronized against other threads' edits.
+ * @param shards Number of shards (0 for one per online CPU, at most 64).
+ * @param ordered true to keep elements in global append order, which costs
+ * every append one shared atomic increment; false keeps each thread's appends
+ * in order but groups them by shard.
+ * @return Pointer to the newly created list, or NULL on failure.
+ */
+List *list_create_sharded(size_t shards, bool ordered);
+
+/**
+ * @brief Create a new LIST_BOUNDED queue with a chosen capacity (list_create
+ * uses 1024). All operations take the queue's mutex; list_push_back and
+ * list_pop_front fail at once on a full or empty queue, while the _wait and
+ * _timed variants sleep until there is room or an element. Edits past the
+ * capacity fail, and iterating is not synchronized against other threads'
+ * edits.
+ * @param capacity Most elements the queue holds at once (at least 1).
+ * @return Pointer to the newly created list, or NULL on failure.
+ */
+List *list_create_bounded(size_t capacity);
+
+/**
+ * @struct ListAllocator
+ * @brief Allocation options for list_create_with_allocator. Zero-initialize
+ * it and set only the options you need.
+ */
+typedef struct ListAllocator {
+  // Nodes carved out of each pool slab (0 disables the node pool). Pooled
+  // nodes are recycled through a free list and released slab by slab when the
+  // list is destroyed. Sentinel lists pool the element nodes handed out by
+  // list_node_alloc; unrolled and tree lists pool their internal nodes.
+  size_t pool_slab_nodes;
+  // Size of the element nodes list_node_alloc hands out for a pooled sentinel
+  // list, so callers can embed their node in a larger struct (0: a bare node)
+  size_t node_size;
+  // Allocation hooks for every internal allocation of the list (headers,
+  // buffers, internal nodes, pool slabs). Leave both NULL for malloc/free;
+  // set both or neither. alloc must align like malloc; cache-line (64-byte)
+  // alignment additionally helps pool slabs and unrolled blocks.
+  void *(*alloc)(void *ctx, size_t size);
+  void (*free)(void *ctx, void *ptr);
+  // Opaque pointer passed back to alloc and free
+  void *ctx;
+} ListAllocator;
+
+/**
+ * @brief Create a new list of the specified type with allocation options.
+ * @param type The type of list to create (e.g., LIST_LINKED_SENTINEL).
+ * @param allocator Allocation options, or NULL for the list_create defaults.
+ * @return Pointer to the newly created list, or NULL on failure.
+ */
+List *list_create_with_allocator(ListType type, const ListAllocator *allocator);
+
+/**
+ * @brief Allocate an element node for a LIST_LINKED_SENTINEL list, from the
+ * list's node pool when one is configured.
+ *
+ * Pooled nodes belong to the pool: list_destroy releases them together with
+ * their slabs, so a free_func given for a pooled list must only release
+ * payload resources (or be NULL), and pooled nodes must not outlive the list.
+ * @param list Pointer to the list.
+ * @return Pointer to the new node, or NULL on failure (or for other types).
+ */
+void *list_node_alloc(List *list);
+
+/**
+ * @brief Give back a node obtained from list_node_alloc (e.g., after removing
+ * it), recycling it through the pool when one is configured.
+ * @param list Pointer to the list the node was allocated for.
+ * @param node Pointer to the node.
+ */
+void list_node_free(List *list, void *node);
+
+/**
+ * @def LIST_STORAGE_SIZE
+ * @brief Bytes of caller storage list_init needs for a list.
+ */
+#define LIST_STORAGE_SIZE 128
+
+/**
+ * @union ListStorage
+ * @brief Suitably sized and aligned storage for a list placed on the stack or
+ * in an arena. Pass `(List *)&storage` to list_init.
+ */
+typedef union ListStorage {
+  max_align_t align;
+  unsigned char bytes[LIST_STORAGE_SIZE];
+} ListStorage;
+
+/**
+ * @brief Initialize a list of the specified type in caller-provided storage.
+ * The header lives in `storage`; a sentinel list then makes no heap
+ * allocations (other types allocate buffers or internal nodes as they grow,
+ * and a skip list allocates its head node up front). The storage must not
+ * move while the list is in use.
+ * @param storage Pointer to at least LIST_STORAGE_SIZE bytes aligned like
+ * ListStorage.
+ * @param type The type of list to create (e.g., LIST_LINKED_SENTINEL).
+ * @return true on success, false on failure.
+ */
+bool list_init(List *storage, ListType type);
+
+/**
+ * @brief Release a list set up with list_init. The storage itself is left to
+ * the caller and may be reused with list_init.
+ * @param list Pointer to the list to release.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void list_deinit(List *list, FreeFunc free_func);
+
 /**
  * @brief Destroy the list and free all associated memory.
  * @param list Pointer to the list to destroy.
@@ -41,6 +194,21 @@ List *list_create(ListType type);
  */
 void list_destroy(List *list, FreeFunc free_func);
 
+/**
+ * @brief Remove every element and reset the list in place so it can be
+ * reused without being destroyed and created again. Buffers stay allocated.
+ *
+ * When the list is the only user of its node pool, the pool takes every node
+ * back at once and its slabs are reused by later allocations. That
+ * invalidates every node taken from the pool, including removed nodes the
+ * caller still holds. With a shared pool (e.g., after list_split_at), pooled
+ * element nodes of a sentinel list stay allocated until the pool is released.
+ * @param list Pointer to the list to clear.
+ * @param free_func Function to free individual elements. If NULL, elements are
+ * not freed.
+ */
+void list_clear(List *list, FreeFunc free_func);
+
 /**
  * @brief Append an element to the end of the list.
  * @param list Pointer to the list.
@@ -58,6 +226,62 @@ bool list_append(List *list, void *data);
  */
 bool list_insert(List *list, size_t index, void *data);
 
+/**
+ * @brief Append a batch of elements to the end of the list in one pass.
+ * @param list Pointer to the list.
+ * @param items Array of `count` pointers to the data to append, in order.
+ * @param count Number of elements in `items`.
+ * @return true on success, false on failure (e.g., an invalid element, in
+ * which case nothing is appended).
+ */
+bool list_append_many(List *list, void **items, size_t count);
+
+/**
+ * @brief Insert a batch of elements starting at a specific index in one pass.
+ * @param list Pointer to the list.
+ * @param index Index at which the first element is inserted.
+ * @param items Array of `count` pointers to the data to insert, in order.
+ * @param count Number of elements in `items`.
+ * @return true on success, false on failure (e.g., index out of bounds or an
+ * invalid element, in which case nothing is inserted).
+ */
+bool list_insert_many(List *list, size_t index, void **items, size_t count);
+
+/**
+ * @brief Move every element of `src` into `dst`, starting at a specific index.
+ * Linked implementations relink instead of copying, so a sentinel list splice
+ * costs O(1) at either end plus the position lookup otherwise.
+ * @param dst Pointer to the list receiving the elements.
+ * @param index Index in `dst` at which the first element of `src` lands.
+ * @param src Pointer to the donor list; it is left empty and valid.
+ * @return true on success, false on failure (e.g., index out of bounds, the
+ * lists are the same list or have different types, or they are sentinel lists
+ * that don't share one node pool). A failed splice moves nothing.
+ */
+bool list_splice(List *dst, size_t index, List *src);
+
+/**
+ * @brief Move every element of `src` to the end of `dst`.
+ * @param dst Pointer to the list receiving the elements.
+ * @param src Pointer to the donor list; it is left empty and valid.
+ * @return true on success, false on failure (e.g., the lists are the same list
+ * or have different types, or they are sentinel lists that don't share one
+ * node pool).
+ */
+bool list_concat(List *dst, List *src);
+
+/**
+ * @brief Split a list in two, moving the elements from a specific index
+ * onwards into a new list of the same type. Linked implementations relink in
+ * place, so cutting successive chunks off the front of a sentinel list costs
+ * one traversal in total.
+ * @param list Pointer to the list; it keeps the elements before `index`.
+ * @param index Index of the first element moved to the new list.
+ * @return Pointer to the new list holding the suffix (possibly empty), or NULL
+ * on failure (e.g., index out of bounds).
+ */
+List *list_split_at(List *list, size_t index);
+
 /**
  * @brief Remove an element at a specific index.
  * @param list Pointer to the list.
@@ -67,7 +291,62 @@ bool list_insert(List *list, size_t index, void *data);
 void *list_remove(List *list, size_t index);
 
 /**
- * @brief Get a pointer the element at a specific index.
+ * @brief Insert an element at the front of the list without a positional
+ * lookup: O(1) for the linked and unrolled types, O(log n) for LIST_SKIP and
+ * LIST_TREE, and a shift for LIST_ARRAY (LIST_GAP_BUFFER pays it once per run
+ * of front pushes).
+ * @param list Pointer to the list.
+ * @param data Pointer to the data to insert.
+ * @return true on success, false on failure (or if the type can't push at
+ * the front).
+ */
+bool list_push_front(List *list, void *data);
+
+/**
+ * @brief Insert an element at the back of the list (same as list_append). A
+ * full LIST_BOUNDED queue fails rather than waits.
+ * @param list Pointer to the list.
+ * @param data Pointer to the data to insert.
+ * @return true on success, false on failure.
+ */
+bool list_push_back(List *list, void *data);
+
+/**
+ * @brief Remove the element at the front of the list without a positional
+ * lookup (a steal for LIST_DEQUE_LOCKFREE, safe from any thread). An empty
+ * LIST_BOUNDED queue returns NULL rather than waits.
+ * @param list Pointer to the list.
+ * @return Pointer to the element, or NULL if the list is empty.
+ */
+void *list_pop_front(List *list);
+
+/**
+ * @brief Remove the element at the back of the list without a positional
+ * lookup. LIST_MPSC can't pop at the back.
+ * @param list Pointer to the list.
+ * @return Pointer to the element, or NULL if the list is empty.
+ */
+void *list_pop_back(List *list);
+
+/**
+ * @brief Get the element at the front of the list without removing it.
+ * @param list Pointer to the list.
+ * @return Pointer to the element, or NULL if the list is empty.
+ */
+void *list_peek_front(const List *list);
+
+/**
+ * @brief Get the element at the back of the list without removing it.
+ * @param list Pointer to the list.
+ * @return Pointer to the element, or NULL if the list is empty.
+ */
+void *list_peek_back(const List *list);
+
+/**
+ * @brief Get a pointer the element at a specific index. A
+ * LIST_LINKED_SENTINEL lookup caches the node it found (the finger) so nearby
+ * lookups walk less; that is a write, so such a list must not be read from
+ * several threads at once (LIST_CONCURRENT lookups leave the finger alone).
  * @param list Pointer to the list.
  * @param index Index of the element to retrieve.
  * @return Pointer to the element, or NULL if index is out of bounds.
@@ -88,4 +367,218 @@ size_t list_size(const List *list);
  */
 bool list_is_empty(const List *list);
 
+/**
+ * @brief Enter a read-side section of a LIST_RCU list. Nodes reached inside
+ * it stay valid until the matching list_rcu_read_unlock. Sections may nest
+ * but must not call anything that edits the list. Each costs one atomic add
+ * on a counter shared by the threads hashed to its slot. A no-op for other
+ * types.
+ * @param list Pointer to the list.
+ * @return Token to pass to list_rcu_read_unlock.
+ */
+size_t list_rcu_read_lock(const List *list);
+
+/**
+ * @brief Leave a read-side section entered with list_rcu_read_lock.
+ * @param list Pointer to the list.
+ * @param token Token returned by list_rcu_read_lock.
+ */
+void list_rcu_read_unlock(const List *list, size_t token);
+
+/**
+ * @brief Insert an element at the back of a LIST_BOUNDED queue, waiting while
+ * it is full. Other types push without waiting.
+ * @param list Pointer to the list.
+ * @param data Pointer to the data to insert.
+ * @return true on success, false on failure or if the queue was closed.
+ */
+bool list_push_back_wait(List *list, void *data);
+
+/**
+ * @brief Insert an element at the back of a LIST_BOUNDED queue, waiting at
+ * most a timeout while it is full. Other types push without waiting.
+ * @param list Pointer to the list.
+ * @param data Pointer to the data to insert.
+ * @param timeout_ms Most milliseconds to wait (0 doesn't wait; SIZE_MAX
+ * waits as long as it takes).
+ * @return true on success, false on failure, timeout or if the queue was
+ * closed.
+ */
+bool list_push_back_timed(List *list, void *data, size_t timeout_ms);
+
+/**
+ * @brief Remove the element at the front of a LIST_BOUNDED queue, waiting
+ * while it is empty. Other types pop without waiting.
+ * @param list Pointer to the list.
+ * @return Pointer to the element, or NULL if the queue was closed and empty.
+ */
+void *list_pop_front_wait(List *list);
+
+/**
+ * @brief Remove the element at the front of a LIST_BOUNDED queue, waiting at
+ * most a timeout while it is empty. Other types pop without waiting.
+ * @param list Pointer to the list.
+ * @param timeout_ms Most milliseconds to wait (0 doesn't wait; SIZE_MAX
+ * waits as long as it takes).
+ * @return Pointer to the element, or NULL on timeout or if the queue was
+ * closed and empty.
+ */
+void *list_pop_front_timed(List *list, size_t timeout_ms);
+
+/**
+ * @brief Close a LIST_BOUNDED queue, e.g. at shutdown: pushes fail from then
+ * on, and pops take the elements left and then return NULL instead of
+ * waiting. Every waiting thread is woken. A no-op for other types.
+ * @param list Pointer to the list.
+ */
+void list_bounded_close(List *list);
+
+/**
+ * @struct ListIter
+ * @brief Cursor over a list. Stepping and editing through a cursor avoids the
+ * per-call index lookup of list_get, so full scans are linear. The fields are
+ * managed by the iter_* functions and must not be changed by the caller.
+ *
+ * A cursor is either on an element or one past the last element (the end).
+ * Editing the list other than through this cursor invalidates it.
+ */
+typedef struct ListIter {
+  List *list;
+  size_t index;  // index of the current element (list size at the end)
+  void *cursor;  // implementation specific position
+  size_t offset; // slot inside `cursor` for block based implementations
+} ListIter;
+
+/**
+ * @brief Get a cursor on the first element (the end if the list is empty).
+ * @param list Pointer to the list.
+ * @return The cursor.
+ */
+ListIter iter_begin(List *list);
+
+/**
+ * @brief Get a cursor one past the last element.
+ * @param list Pointer to the list.
+ * @return The cursor.
+ */
+ListIter iter_end(List *list);
+
+/**
+ * @brief Move the cursor to the next element.
+ * @param iter Pointer to the cursor.
+ * @return true if the cursor is on an element afterwards, false at the end.
+ */
+bool iter_next(ListIter *iter);
+
+/**
+ * @brief Move the cursor to the previous element.
+ * @param iter Pointer to the cursor.
+ * @return true on success, false if the cursor was already on the first
+ * element (it does not move).
+ */
+bool iter_prev(ListIter *iter);
+
+/**
+ * @brief Get the element under the cursor.
+ * @param iter Pointer to the cursor.
+ * @return Pointer to the element, or NULL at the end.
+ */
+void *iter_get(const ListIter *iter);
+
+/**
+ * @brief Insert an element right before the cursor. The cursor stays on the
+ * same element (at the end, this appends).
+ * @param iter Pointer to the cursor.
+ * @param data Pointer to the data to insert.
+ * @return true on success, false on failure.
+ */
+bool iter_insert(ListIter *iter, void *data);
+
+/**
+ * @brief Remove the element under the cursor. The cursor moves to the element
+ * that followed it.
+ * @param iter Pointer to the cursor.
+ * @return Pointer to the element, or NULL at the end.
+ */
+void *iter_remove(ListIter *iter);
+
+/**
+ * @typedef ListVisitFunc
+ * @brief Function called on each element by list_parallel_for_each, with the
+ * element's index and the caller's context.
+ */
+typedef void (*ListVisitFunc)(void *data, size_t index, void *ctx);
+
+/**
+ * @brief Call a function on every element, splitting the list into one
+ * contiguous range per thread and running the ranges on a small built-in
+ * thread pool (the calling thread takes a range too). Linked types place
+ * the ranges with a single walk. Calls for different elements may run at
+ * the same time and in any order; the list must not be edited until the
+ * call returns (a LIST_RCU list may be, by other threads). Parallel calls
+ * from different threads take turns on the pool, and a nested call runs on
+ * the calling thread alone.
+ * @param list Pointer to the list.
+ * @param fn Function to call on each element.
+ * @param ctx Context passed to every call of `fn`.
+ * @param nthreads Most threads to use, or 0 for one per online CPU. Lists
+ * too short to be worth splitting use fewer.
+ */
+void list_parallel_for_each(List *list, ListVisitFunc fn, void *ctx,
+                            size_t nthreads);
+
+/**
+ * @typedef ListCompareFunc
+ * @brief Function comparing two elements for list_sort: negative if `a`
+ * goes before `b`, positive if after, 0 if either order will do. It is
+ * passed the elements themselves (the nodes, for node-based types), not
+ * pointers to them as with qsort.
+ */
+typedef int (*ListCompareFunc)(const void *a, const void *b);
+
+/**
+ * @brief Sort the list with a stable merge sort (equal elements keep their
+ * order). Node-based types relink their nodes in place without allocating;
+ * the others sort their element pointers through a scratch buffer. Lock-free
+ * and RCU lists can't be sorted.
+ * @param list Pointer to the list.
+ * @param cmp Comparison function.
+ * @return true on success, false if the type can't be sorted or the scratch
+ * buffer couldn't be allocated.
+ */
+bool list_sort(List *list, ListCompareFunc cmp);
+
+/**
+ * @brief Sort the list like list_sort, on several threads: contiguous runs
+ * are sorted on the list_parallel_for_each thread pool, then merged pairwise
+ * (also in parallel) into one.
+ * @param list Pointer to the list.
+ * @param cmp Comparison function (called from several threads at once).
+ * @param nthreads Most threads to use, or 0 for one per online CPU. Lists
+ * too short to be worth splitting use fewer.
+ * @return true on success, false if the type can't be sorted or the scratch
+ * buffer couldn't be allocated.
+ */
+bool list_sort_parallel(List *list, ListCompareFunc cmp, size_t nthreads);
+
+/**
+ * @typedef ListKeyFunc
+ * @brief Function giving an element's unsigned 64-bit sort key (flip the
+ * sign bit of signed keys so they order the same way).
+ */
+typedef uint64_t (*ListKeyFunc)(const void *data);
+
+/**
+ * @brief Sort the list by integer key with a stable LSD radix sort. Each key
+ * is extracted once into a scratch buffer (two key/element pairs per
+ * element), sorted a byte at a time without comparisons, and node-based
+ * types are then relinked in a single pass. Supports the same types as
+ * list_sort.
+ * @param list Pointer to the list.
+ * @param key_fn Function giving each element's key.
+ * @return true on success, false if the type can't be sorted or the scratch
+ * buffer couldn't be allocated.
+ */
+bool list_sort_by_key(List *list, ListKeyFunc key_fn);
+
 #endif // LAB_H
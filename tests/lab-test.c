@@ -1,8 +1,12 @@
 #include "../src/lab.h"
 #include "harness/unity.h"
 #include "harness/unity_internals.h"
+#include <pthread.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 // AI Use: Assisted by AI
 // Needed a way to check (void* data) parameter is a node
@@ -16,40 +20,60 @@ typedef struct Node {
 typedef struct SentinelLinkedList {
   Node *head, *tail;
   size_t size;
+  Node *finger;
+  size_t finger_index;
+  Node sentinel;
 } SentinelLinkedList;
 
 typedef struct List {
   ListType type;
+  bool owned;
 
   // AI Use: Assisted by AI
   // I needed a form of inheritence to keep this type generic
+  // The sentinel list is the largest member, so it sets the union's size
   union {
-    struct SentinelLinkedList *sentinel_list;
+    struct SentinelLinkedList sentinel_list;
   } lists;
+
+  ListAllocator allocator;
+  struct NodePool *pool;
 } List;
 
 int test_element = 4; // int simply for testing
 
 extern void free_node(void *data_ptr);
 
+// Single-threaded types, which support every list operation
+static const ListType sequential_types[] = {
+    LIST_LINKED_SENTINEL, LIST_ARRAY, LIST_GAP_BUFFER,
+    LIST_UNROLLED,        LIST_SKIP,  LIST_TREE};
+static const size_t sequential_type_count =
+    sizeof(sequential_types) / sizeof(sequential_types[0]);
+
+// Wall clock in seconds for the throughput comparisons
+double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
 void setUp(void) { printf("\nSetting up tests...\n"); }
 
 void tearDown(void) { printf("\nTearing down tests...\n"); }
 
 void test_list_create(void) {
   List *list = list_create(LIST_LINKED_SENTINEL);
-  SentinelLinkedList *sentinel_list_ptr = list->lists.sentinel_list;
-
   TEST_ASSERT_NOT_NULL(list);
-  TEST_ASSERT_NOT_NULL(sentinel_list_ptr);
-  TEST_ASSERT_NOT_NULL(sentinel_list_ptr->head);
+  SentinelLinkedList *sentinel_list_ptr = &list->lists.sentinel_list;
+
+  // The sentinel lives inline in the header
+  TEST_ASSERT_EQUAL_PTR(&sentinel_list_ptr->sentinel, sentinel_list_ptr->head);
   TEST_ASSERT_NOT_NULL(sentinel_list_ptr->tail);
   TEST_ASSERT_EQUAL(sentinel_list_ptr->head, sentinel_list_ptr->tail);
 
   // Free manually to avoid premature stacktraces (tests destroy separately)
-  free(list->lists.sentinel_list->head); // frees sentinel
-  free(list->lists.sentinel_list);
-  free(list);
+  free(list); // frees the sentinel with the header
   sentinel_list_ptr = NULL;
   list = NULL;
 }
@@ -66,7 +90,7 @@ void test_append(void) {
   List *list = list_create(LIST_LINKED_SENTINEL);
   TEST_ASSERT_NOT_NULL(list);
 
-  SentinelLinkedList *sentinel_list = list->lists.sentinel_list;
+  SentinelLinkedList *sentinel_list = &list->lists.sentinel_list;
   Node *newNode = malloc(sizeof(Node));
   Node *newNode2 = malloc(sizeof(Node));
   newNode->type = newNode2->type = NODE;
@@ -82,7 +106,7 @@ void test_append(void) {
   // New node -> Sentinel
   TEST_ASSERT_EQUAL(sentinel_list->tail->prev, sentinel_list->head);
   TEST_ASSERT_EQUAL(sentinel_list->tail->next, sentinel_list->head);
-  TEST_ASSERT_EQUAL(1, list->lists.sentinel_list->size);
+  TEST_ASSERT_EQUAL(1, list->lists.sentinel_list.size);
 
   // Append second item (testing shifting and pointers)
   bool item_appended2 = list_append(list, newNode2);
@@ -95,12 +119,12 @@ void test_append(void) {
   TEST_ASSERT_NOT_EQUAL(sentinel_list->head->next, sentinel_list->tail);
   // New Node !(->) Sentinel
   TEST_ASSERT_NOT_EQUAL(sentinel_list->tail->prev, sentinel_list->head);
-  TEST_ASSERT_EQUAL(2, list->lists.sentinel_list->size);
+  TEST_ASSERT_EQUAL(2, list->lists.sentinel_list.size);
 
   // Append a non-node item
   bool non_node_appended = list_append(list, &test_element);
   TEST_ASSERT_FALSE(non_node_appended);
-  TEST_ASSERT_EQUAL(2, list->lists.sentinel_list->size);
+  TEST_ASSERT_EQUAL(2, list->lists.sentinel_list.size);
 
   // Cleanup
   list_destroy(list, free_node);
@@ -112,7 +136,7 @@ void test_append(void) {
 void test_insert(void) {
   int test_element_2 = 2;
   List *list = list_create(LIST_LINKED_SENTINEL);
-  SentinelLinkedList *sentinel_list = list->lists.sentinel_list;
+  SentinelLinkedList *sentinel_list = &list->lists.sentinel_list;
   Node *node1 = malloc(sizeof(Node));
   node1->type = NODE;
 
@@ -147,7 +171,7 @@ void test_insert(void) {
   // Append a non-node item
   bool non_node_appended = list_append(list, &test_element);
   TEST_ASSERT_FALSE(non_node_appended);
-  TEST_ASSERT_EQUAL(3, list->lists.sentinel_list->size);
+  TEST_ASSERT_EQUAL(3, list->lists.sentinel_list.size);
 
   // Cleanup
   list_destroy(list, free_node);
@@ -243,7 +267,7 @@ void test_remove(void) {
 
 void test_remove_out_of_bounds(void) {
   List *list = list_create(LIST_LINKED_SENTINEL);
-  SentinelLinkedList *sentinel_list = list->lists.sentinel_list;
+  SentinelLinkedList *sentinel_list = &list->lists.sentinel_list;
   Node *newNode = malloc(sizeof(Node));
   newNode->type = NODE;
   list_append(list, newNode);
@@ -268,7 +292,7 @@ void test_remove_out_of_bounds(void) {
 
 void test_list_size(void) {
   List *list = list_create(LIST_LINKED_SENTINEL);
-  SentinelLinkedList *sentinel_list = list->lists.sentinel_list;
+  SentinelLinkedList *sentinel_list = &list->lists.sentinel_list;
   Node *node1 = malloc(sizeof(Node));
   Node *node2 = malloc(sizeof(Node));
 
@@ -306,6 +330,2023 @@ void test_list_is_empty(void) {
   list = NULL;
 }
 
+void test_array_list_append_get(void) {
+  List *list = list_create(LIST_ARRAY);
+  TEST_ASSERT_NOT_NULL(list);
+  int values[20];
+
+  // Append enough elements to force the buffer to grow
+  for (int i = 0; i < 20; i++) {
+    values[i] = i;
+    TEST_ASSERT_TRUE(list_append(list, &values[i]));
+  }
+  TEST_ASSERT_EQUAL(20, list_size(list));
+  for (int i = 0; i < 20; i++)
+    TEST_ASSERT_EQUAL_PTR(&values[i], list_get(list, (size_t)i));
+
+  // Out of bounds and NULL elements are rejected
+  TEST_ASSERT_NULL(list_get(list, 20));
+  TEST_ASSERT_FALSE(list_append(list, NULL));
+
+  // Cleanup (elements live on the stack)
+  list_destroy(list, NULL);
+  list = NULL;
+}
+
+void test_array_list_insert_remove(void) {
+  List *list = list_create(LIST_ARRAY);
+  int a = 1, b = 2, c = 3;
+
+  TEST_ASSERT_TRUE(list_is_empty(list));
+  TEST_ASSERT_TRUE(list_insert(list, 0, &c)); // c
+  TEST_ASSERT_TRUE(list_insert(list, 0, &a)); // a c
+  TEST_ASSERT_TRUE(list_insert(list, 1, &b)); // a b c
+  TEST_ASSERT_FALSE(list_insert(list, 4, &b));
+  TEST_ASSERT_EQUAL_PTR(&a, list_get(list, 0));
+  TEST_ASSERT_EQUAL_PTR(&b, list_get(list, 1));
+  TEST_ASSERT_EQUAL_PTR(&c, list_get(list, 2));
+
+  // Removing shifts later elements down
+  TEST_ASSERT_EQUAL_PTR(&b, list_remove(list, 1));
+  TEST_ASSERT_EQUAL_PTR(&c, list_get(list, 1));
+  TEST_ASSERT_NULL(list_remove(list, 2));
+  TEST_ASSERT_EQUAL_PTR(&a, list_remove(list, 0));
+  TEST_ASSERT_EQUAL_PTR(&c, list_remove(list, 0));
+  TEST_ASSERT_TRUE(list_is_empty(list));
+
+  // Cleanup
+  list_destroy(list, NULL);
+  list = NULL;
+}
+
+void test_array_list_destroy_frees_elements(void) {
+  List *list = list_create(LIST_ARRAY);
+  for (int i = 0; i < 3; i++)
+    list_append(list, malloc(sizeof(int)));
+
+  // free() releases every element (checked by make leak-test)
+  list_destroy(list, free);
+  list = NULL;
+  TEST_ASSERT_NULL(list);
+}
+
+void test_gap_buffer_cursor_edits(void) {
+  List *list = list_create(LIST_GAP_BUFFER);
+  TEST_ASSERT_NOT_NULL(list);
+  int values[40];
+
+  // Run of inserts at one moving cursor, forcing the buffer to grow
+  for (int i = 0; i < 40; i++) {
+    values[i] = i;
+    TEST_ASSERT_TRUE(list_insert(list, (size_t)i, &values[i]));
+  }
+  TEST_ASSERT_EQUAL(40, list_size(list));
+  for (int i = 0; i < 40; i++)
+    TEST_ASSERT_EQUAL_PTR(&values[i], list_get(list, (size_t)i));
+
+  // Jump the gap back and forth: remove 10, insert before 5, remove last
+  TEST_ASSERT_EQUAL_PTR(&values[10], list_remove(list, 10));
+  TEST_ASSERT_EQUAL_PTR(&values[11], list_get(list, 10));
+  TEST_ASSERT_TRUE(list_insert(list, 5, &values[10]));
+  TEST_ASSERT_EQUAL_PTR(&values[10], list_get(list, 5));
+  TEST_ASSERT_EQUAL_PTR(&values[5], list_get(list, 6));
+  TEST_ASSERT_EQUAL_PTR(&values[39], list_remove(list, 39));
+  TEST_ASSERT_EQUAL_PTR(&values[38], list_get(list, 38));
+  TEST_ASSERT_EQUAL(39, list_size(list));
+
+  // Out of bounds
+  TEST_ASSERT_NULL(list_get(list, 39));
+  TEST_ASSERT_NULL(list_remove(list, 39));
+  TEST_ASSERT_FALSE(list_insert(list, 40, &values[0]));
+  TEST_ASSERT_TRUE(list_append(list, &values[39]));
+  TEST_ASSERT_EQUAL_PTR(&values[39], list_get(list, 39));
+
+  // Cleanup (elements live on the stack)
+  list_destroy(list, NULL);
+  list = NULL;
+}
+
+void test_gap_buffer_destroy_frees_elements(void) {
+  List *list = list_create(LIST_GAP_BUFFER);
+  for (int i = 0; i < 3; i++)
+    list_append(list, malloc(sizeof(int)));
+  // Leave the gap in the middle so both halves get freed
+  free(list_remove(list, 1));
+  list_insert(list, 1, malloc(sizeof(int)));
+  free(list_remove(list, 1));
+
+  list_destroy(list, free);
+  list = NULL;
+  TEST_ASSERT_NULL(list);
+}
+
+void test_unrolled_list_matches_array(void) {
+  List *list = list_create(LIST_UNROLLED);
+  List *expected = list_create(LIST_ARRAY);
+  TEST_ASSERT_NOT_NULL(list);
+  int values[200];
+
+  // Mixed appends, front/middle inserts and removes spanning many blocks
+  for (int i = 0; i < 200; i++) {
+    values[i] = i;
+    size_t index = (i % 3 == 0) ? 0 : list_size(list) / 2;
+    if (i % 5 == 0)
+      index = list_size(list);
+    TEST_ASSERT_TRUE(list_insert(list, index, &values[i]));
+    TEST_ASSERT_TRUE(list_insert(expected, index, &values[i]));
+  }
+  for (int i = 0; i < 150; i++) {
+    size_t index = ((size_t)i * 7) % list_size(list);
+    TEST_ASSERT_EQUAL_PTR(list_remove(expected, index),
+                          list_remove(list, index));
+  }
+
+  TEST_ASSERT_EQUAL(list_size(expected), list_size(list));
+  for (size_t i = 0; i < list_size(list); i++)
+    TEST_ASSERT_EQUAL_PTR(list_get(expected, i), list_get(list, i));
+
+  // Out of bounds
+  TEST_ASSERT_NULL(list_get(list, list_size(list)));
+  TEST_ASSERT_NULL(list_remove(list, list_size(list)));
+  TEST_ASSERT_FALSE(list_insert(list, list_size(list) + 1, &values[0]));
+
+  // Drain completely so every block is released
+  while (!list_is_empty(list))
+    list_remove(list, 0);
+  TEST_ASSERT_NULL(list_get(list, 0));
+
+  // Cleanup (elements live on the stack)
+  list_destroy(list, NULL);
+  list_destroy(expected, NULL);
+  list = expected = NULL;
+}
+
+void test_skip_list_matches_array(void) {
+  List *list = list_create(LIST_SKIP);
+  List *expected = list_create(LIST_ARRAY);
+  TEST_ASSERT_NOT_NULL(list);
+  int values[500];
+
+  // Random-ish positional inserts and removes, checked against LIST_ARRAY
+  for (int i = 0; i < 500; i++) {
+    values[i] = i;
+    size_t index = ((size_t)i * 37) % (list_size(list) + 1);
+    TEST_ASSERT_TRUE(list_insert(list, index, &values[i]));
+    TEST_ASSERT_TRUE(list_insert(expected, index, &values[i]));
+  }
+  for (size_t i = 0; i < list_size(list); i++)
+    TEST_ASSERT_EQUAL_PTR(list_get(expected, i), list_get(list, i));
+  for (int i = 0; i < 300; i++) {
+    size_t index = ((size_t)i * 53) % list_size(list);
+    TEST_ASSERT_EQUAL_PTR(list_remove(expected, index),
+                          list_remove(list, index));
+  }
+
+  TEST_ASSERT_EQUAL(list_size(expected), list_size(list));
+  for (size_t i = 0; i < list_size(list); i++)
+    TEST_ASSERT_EQUAL_PTR(list_get(expected, i), list_get(list, i));
+
+  // Out of bounds
+  TEST_ASSERT_NULL(list_get(list, list_size(list)));
+  TEST_ASSERT_NULL(list_remove(list, list_size(list)));
+  TEST_ASSERT_FALSE(list_insert(list, list_size(list) + 1, &values[0]));
+
+  // Cleanup (elements live on the stack)
+  list_destroy(list, NULL);
+  list_destroy(expected, NULL);
+  list = expected = NULL;
+}
+
+void test_tree_list_matches_array(void) {
+  List *list = list_create(LIST_TREE);
+  List *expected = list_create(LIST_ARRAY);
+  TEST_ASSERT_NOT_NULL(list);
+  int values[500];
+
+  // Positional inserts and removes, checked against LIST_ARRAY
+  for (int i = 0; i < 500; i++) {
+    values[i] = i;
+    size_t index = ((size_t)i * 37) % (list_size(list) + 1);
+    TEST_ASSERT_TRUE(list_insert(list, index, &values[i]));
+    TEST_ASSERT_TRUE(list_insert(expected, index, &values[i]));
+  }
+  for (int i = 0; i < 300; i++) {
+    size_t index = ((size_t)i * 53) % list_size(list);
+    TEST_ASSERT_EQUAL_PTR(list_remove(expected, index),
+                          list_remove(list, index));
+  }
+
+  TEST_ASSERT_EQUAL(list_size(expected), list_size(list));
+  for (size_t i = 0; i < list_size(list); i++)
+    TEST_ASSERT_EQUAL_PTR(list_get(expected, i), list_get(list, i));
+
+  // Out of bounds
+  TEST_ASSERT_NULL(list_get(list, list_size(list)));
+  TEST_ASSERT_NULL(list_remove(list, list_size(list)));
+  TEST_ASSERT_FALSE(list_insert(list, list_size(list) + 1, &values[0]));
+
+  // Sequential appends must stay balanced (deterministic worst case)
+  while (!list_is_empty(list))
+    list_remove(list, list_size(list) - 1);
+  for (int i = 0; i < 500; i++)
+    TEST_ASSERT_TRUE(list_append(list, &values[i]));
+  for (int i = 0; i < 500; i++)
+    TEST_ASSERT_EQUAL_PTR(&values[i], list_get(list, (size_t)i));
+
+  // Cleanup (elements live on the stack)
+  list_destroy(list, NULL);
+  list_destroy(expected, NULL);
+  list = expected = NULL;
+}
+
+void test_iterator_all_types(void) {
+  Node nodes[120];
+  for (int i = 0; i < 120; i++)
+    nodes[i].type = NODE;
+
+  for (size_t t = 0; t < sequential_type_count; t++) {
+    ListType type = sequential_types[t];
+    List *list = list_create(type);
+    List *expected = list_create(LIST_ARRAY);
+
+    // Appending through an end cursor
+    ListIter end = iter_end(list);
+    for (int i = 0; i < 60; i++) {
+      TEST_ASSERT_TRUE(iter_insert(&end, &nodes[i]));
+      list_append(expected, &nodes[i]);
+    }
+    TEST_ASSERT_NULL(iter_get(&end));
+    TEST_ASSERT_FALSE(iter_next(&end));
+
+    // In-place edits during one forward pass: drop every third element and
+    // put a new element before every fifth one
+    ListIter iter = iter_begin(list);
+    size_t index = 0;
+    int fresh = 60;
+    for (int i = 0; i < 60; i++) {
+      if (i % 5 == 0) {
+        TEST_ASSERT_TRUE(iter_insert(&iter, &nodes[fresh]));
+        list_insert(expected, index++, &nodes[fresh++]);
+      }
+      if (i % 3 == 0) {
+        TEST_ASSERT_EQUAL_PTR(list_remove(expected, index), iter_remove(&iter));
+      } else {
+        TEST_ASSERT_EQUAL_PTR(list_get(expected, index), iter_get(&iter));
+        iter_next(&iter);
+        index++;
+      }
+    }
+    TEST_ASSERT_NULL(iter_remove(&iter));
+    TEST_ASSERT_EQUAL(list_size(expected), list_size(list));
+
+    // Forward and backward scans see the same order as list_get
+    size_t count = 0;
+    for (iter = iter_begin(list); iter_get(&iter); iter_next(&iter))
+      TEST_ASSERT_EQUAL_PTR(list_get(expected, count++), iter_get(&iter));
+    TEST_ASSERT_EQUAL(list_size(expected), count);
+    for (iter = iter_end(list); iter_prev(&iter);)
+      TEST_ASSERT_EQUAL_PTR(list_get(expected, --count), iter_get(&iter));
+    TEST_ASSERT_EQUAL(0, count);
+
+    // Cleanup (elements live on the stack)
+    while (!list_is_empty(list))
+      list_remove(list, 0);
+    list_destroy(list, (type == LIST_LINKED_SENTINEL) ? free_node : NULL);
+    list_destroy(expected, NULL);
+  }
+}
+
+void test_sequential_get_uses_finger(void) {
+  List *list = list_create(LIST_LINKED_SENTINEL);
+  SentinelLinkedList *sentinel_list = &list->lists.sentinel_list;
+  Node nodes[101];
+  for (int i = 0; i < 101; i++) {
+    nodes[i].type = NODE;
+    if (i < 100)
+      list_append(list, &nodes[i]);
+  }
+
+  // Each lookup leaves the finger on the node it resolved
+  for (size_t i = 0; i < 100; i++) {
+    TEST_ASSERT_EQUAL_PTR(&nodes[i], list_get(list, i));
+    TEST_ASSERT_EQUAL_PTR(&nodes[i], sentinel_list->finger);
+    TEST_ASSERT_EQUAL(i, sentinel_list->finger_index);
+  }
+  // Lookups past the middle (walking back from the tail) stay correct
+  TEST_ASSERT_EQUAL_PTR(&nodes[70], list_get(list, 70));
+  TEST_ASSERT_EQUAL_PTR(&nodes[99], list_get(list, 99));
+  TEST_ASSERT_NULL(list_get(list, 100));
+
+  // Insert and remove keep the finger on a valid index
+  TEST_ASSERT_TRUE(list_insert(list, 50, &nodes[100]));
+  TEST_ASSERT_EQUAL_PTR(&nodes[100], sentinel_list->finger);
+  TEST_ASSERT_EQUAL_PTR(&nodes[50], list_get(list, 51));
+  TEST_ASSERT_EQUAL_PTR(&nodes[100], list_remove(list, 50));
+  TEST_ASSERT_EQUAL_PTR(&nodes[50], sentinel_list->finger);
+  TEST_ASSERT_EQUAL(50, sentinel_list->finger_index);
+  TEST_ASSERT_EQUAL_PTR(&nodes[49], list_get(list, 49));
+
+  // Inserting at index == size appends
+  TEST_ASSERT_TRUE(list_insert(list, 100, &nodes[100]));
+  TEST_ASSERT_EQUAL_PTR(&nodes[100], sentinel_list->tail);
+  TEST_ASSERT_EQUAL_PTR(&nodes[100], list_remove(list, 100));
+  TEST_ASSERT_EQUAL_PTR(&nodes[99], sentinel_list->tail);
+  TEST_ASSERT_NULL(sentinel_list->finger);
+
+  // Cleanup (elements live on the stack)
+  while (!list_is_empty(list))
+    list_remove(list, 0);
+  list_destroy(list, free_node);
+  list = NULL;
+}
+
+void test_insert_many_all_types(void) {
+  Node nodes[60];
+  void *items[60];
+  for (int i = 0; i < 60; i++) {
+    nodes[i].type = NODE;
+    items[i] = &nodes[i];
+  }
+
+  for (size_t t = 0; t < sequential_type_count; t++) {
+    ListType type = sequential_types[t];
+    List *list = list_create(type);
+
+    // [0..20) then [40..60) then [20..40) spliced into the middle
+    TEST_ASSERT_TRUE(list_append_many(list, items, 20));
+    TEST_ASSERT_TRUE(list_append_many(list, &items[40], 20));
+    TEST_ASSERT_TRUE(list_insert_many(list, 20, &items[20], 20));
+    TEST_ASSERT_TRUE(list_insert_many(list, 0, NULL, 0));
+    TEST_ASSERT_EQUAL(60, list_size(list));
+    for (size_t i = 0; i < 60; i++)
+      TEST_ASSERT_EQUAL_PTR(&nodes[i], list_get(list, i));
+
+    // Out of bounds or invalid elements insert nothing
+    void *bad[2] = {&nodes[0], NULL};
+    TEST_ASSERT_FALSE(list_insert_many(list, 61, items, 1));
+    TEST_ASSERT_FALSE(list_append_many(list, bad, 2));
+    TEST_ASSERT_EQUAL(60, list_size(list));
+
+    // Cleanup (elements live on the stack)
+    while (!list_is_empty(list))
+      list_remove(list, list_size(list) - 1);
+    list_destroy(list, (type == LIST_LINKED_SENTINEL) ? free_node : NULL);
+  }
+}
+
+void test_append_many_throughput(void) {
+  const size_t count = 200000;
+  Node *nodes = malloc(count * sizeof(Node));
+  void **items = malloc(count * sizeof(void *));
+  for (size_t i = 0; i < count; i++) {
+    nodes[i].type = NODE;
+    items[i] = &nodes[i];
+  }
+
+  // One list_append per node
+  List *list = list_create(LIST_LINKED_SENTINEL);
+  double start = now_seconds();
+  for (size_t i = 0; i < count; i++)
+    list_append(list, items[i]);
+  double single = now_seconds() - start;
+  TEST_ASSERT_EQUAL(count, list_size(list));
+  while (!list_is_empty(list))
+    list_remove(list, 0);
+
+  // The same batch linked in one pass
+  start = now_seconds();
+  TEST_ASSERT_TRUE(list_append_many(list, items, count));
+  double batched = now_seconds() - start;
+  TEST_ASSERT_EQUAL(count, list_size(list));
+  TEST_ASSERT_EQUAL_PTR(&nodes[count - 1], list_get(list, count - 1));
+
+  printf("\nappend x%zu: %.3f ms, append_many: %.3f ms\n", count,
+         single * 1e3, batched * 1e3);
+
+  // Cleanup
+  while (!list_is_empty(list))
+    list_remove(list, 0);
+  list_destroy(list, free_node);
+  free(items);
+  free(nodes);
+}
+
+void test_splice_concat_all_types(void) {
+  Node nodes[90];
+  void *items[90];
+  for (int i = 0; i < 90; i++) {
+    nodes[i].type = NODE;
+    items[i] = &nodes[i];
+  }
+
+  for (size_t t = 0; t < sequential_type_count; t++) {
+    ListType type = sequential_types[t];
+    List *dst = list_create(type);
+    List *src = list_create(type);
+
+    // dst = [0..20) + [50..70), src = [20..50) spliced into the middle
+    list_append_many(dst, items, 20);
+    list_append_many(dst, &items[50], 20);
+    list_append_many(src, &items[20], 30);
+    TEST_ASSERT_TRUE(list_splice(dst, 20, src));
+    TEST_ASSERT_TRUE(list_is_empty(src));
+    TEST_ASSERT_NULL(list_get(src, 0));
+
+    // The donor stays usable: refill it and concatenate at the end
+    list_append_many(src, &items[70], 20);
+    TEST_ASSERT_TRUE(list_concat(dst, src));
+    TEST_ASSERT_TRUE(list_is_empty(src));
+    TEST_ASSERT_TRUE(list_concat(dst, src)); // empty donor is a no-op
+
+    TEST_ASSERT_EQUAL(90, list_size(dst));
+    size_t count = 0;
+    for (ListIter iter = iter_begin(dst); iter_get(&iter); iter_next(&iter))
+      TEST_ASSERT_EQUAL_PTR(&nodes[count++], iter_get(&iter));
+    TEST_ASSERT_EQUAL(90, count);
+
+    // Out of bounds, self splice and mixed types are rejected
+    List *other =
+        list_create((type == LIST_ARRAY) ? LIST_TREE : LIST_ARRAY);
+    TEST_ASSERT_FALSE(list_splice(dst, 91, src));
+    TEST_ASSERT_FALSE(list_concat(dst, dst));
+    TEST_ASSERT_FALSE(list_concat(dst, other));
+
+    // Cleanup (elements live on the stack)
+    while (!list_is_empty(dst))
+      list_remove(dst, list_size(dst) - 1);
+    FreeFunc cleanup = (type == LIST_LINKED_SENTINEL) ? free_node : NULL;
+    list_destroy(dst, cleanup);
+    list_destroy(src, cleanup);
+    list_destroy(other, NULL);
+  }
+}
+
+void test_split_at_all_types(void) {
+  Node nodes[100];
+  void *items[100];
+  for (int i = 0; i < 100; i++) {
+    nodes[i].type = NODE;
+    items[i] = &nodes[i];
+  }
+
+  for (size_t t = 0; t < sequential_type_count; t++) {
+    ListType type = sequential_types[t];
+    List *list = list_create(type);
+    list_append_many(list, items, 100);
+    TEST_ASSERT_NULL(list_split_at(list, 101));
+
+    // Partition 4 ways by repeatedly cutting chunks off the front
+    List *chunks[4];
+    List *rest = list;
+    for (size_t c = 0; c < 3; c++) {
+      chunks[c] = rest;
+      rest = list_split_at(rest, 25);
+      TEST_ASSERT_NOT_NULL(rest);
+      TEST_ASSERT_EQUAL(25, list_size(chunks[c]));
+    }
+    chunks[3] = rest;
+    TEST_ASSERT_EQUAL(25, list_size(chunks[3]));
+
+    // Every chunk holds its own contiguous run and stays editable
+    for (size_t c = 0; c < 4; c++) {
+      for (size_t i = 0; i < 25; i++)
+        TEST_ASSERT_EQUAL_PTR(&nodes[c * 25 + i], list_get(chunks[c], i));
+      TEST_ASSERT_EQUAL_PTR(&nodes[c * 25 + 24], list_remove(chunks[c], 24));
+      TEST_ASSERT_TRUE(list_append(chunks[c], &nodes[c * 25 + 24]));
+    }
+
+    // Splitting at the end gives an empty list
+    List *empty = list_split_at(chunks[3], 25);
+    TEST_ASSERT_NOT_NULL(empty);
+    TEST_ASSERT_TRUE(list_is_empty(empty));
+    TEST_ASSERT_EQUAL(25, list_size(chunks[3]));
+
+    // Cleanup (elements live on the stack)
+    FreeFunc cleanup = (type == LIST_LINKED_SENTINEL) ? free_node : NULL;
+    for (size_t c = 0; c < 4; c++) {
+      while (!list_is_empty(chunks[c]))
+        list_remove(chunks[c], 0);
+      list_destroy(chunks[c], cleanup);
+    }
+    list_destroy(empty, cleanup);
+  }
+}
+
+void test_node_pool_recycles_sentinel_nodes(void) {
+  ListAllocator allocator = {.pool_slab_nodes = 4};
+  List *list = list_create_with_allocator(LIST_LINKED_SENTINEL, &allocator);
+  TEST_ASSERT_NOT_NULL(list);
+  TEST_ASSERT_NOT_NULL(list->pool);
+
+  // Nodes come from slabs of 4 and are already tagged as nodes
+  Node *nodes[10];
+  for (int i = 0; i < 10; i++) {
+    nodes[i] = list_node_alloc(list);
+    TEST_ASSERT_NOT_NULL(nodes[i]);
+    TEST_ASSERT_EQUAL(NODE, nodes[i]->type);
+    TEST_ASSERT_TRUE(list_append(list, nodes[i]));
+  }
+
+  // Removed nodes are recycled before new slab space is used
+  Node *removed = list_remove(list, 3);
+  TEST_ASSERT_EQUAL_PTR(nodes[3], removed);
+  list_node_free(list, removed);
+  Node *recycled = list_node_alloc(list);
+  TEST_ASSERT_EQUAL_PTR(removed, recycled);
+  TEST_ASSERT_TRUE(list_insert(list, 3, recycled));
+  TEST_ASSERT_EQUAL(10, list_size(list));
+
+  // A split shares the pool, so both halves can recycle into it
+  List *suffix = list_split_at(list, 5);
+  TEST_ASSERT_EQUAL_PTR(list->pool, suffix->pool);
+  list_node_free(suffix, list_remove(suffix, 0));
+  TEST_ASSERT_NOT_NULL(list_node_alloc(list));
+
+  // Element nodes belong to the pool: destroy releases them with the slabs
+  list_destroy(suffix, NULL);
+  list_destroy(list, NULL);
+  list = suffix = NULL;
+}
+
+void test_node_pool_splice_needs_shared_pool(void) {
+  ListAllocator allocator = {.pool_slab_nodes = 4};
+  List *pooled = list_create_with_allocator(LIST_LINKED_SENTINEL, &allocator);
+  List *other = list_create_with_allocator(LIST_LINKED_SENTINEL, &allocator);
+  List *plain = list_create(LIST_LINKED_SENTINEL);
+  Node node = {NODE, NULL, NULL};
+  TEST_ASSERT_TRUE(list_append(pooled, list_node_alloc(pooled)));
+  TEST_ASSERT_TRUE(list_append(other, list_node_alloc(other)));
+  TEST_ASSERT_TRUE(list_append(plain, &node));
+
+  // Pool nodes would outlive their slabs in a list with another pool (or none)
+  TEST_ASSERT_FALSE(list_splice(other, 0, pooled));
+  TEST_ASSERT_FALSE(list_concat(plain, pooled));
+  TEST_ASSERT_FALSE(list_concat(pooled, plain));
+  TEST_ASSERT_EQUAL(1, list_size(pooled));
+  TEST_ASSERT_EQUAL(1, list_size(other));
+  TEST_ASSERT_EQUAL(1, list_size(plain));
+
+  // Halves of a split share the pool, so they can be joined again
+  TEST_ASSERT_TRUE(list_append(pooled, list_node_alloc(pooled)));
+  List *suffix = list_split_at(pooled, 1);
+  TEST_ASSERT_TRUE(list_concat(pooled, suffix));
+  TEST_ASSERT_EQUAL(2, list_size(pooled));
+
+  list_destroy(suffix, NULL);
+  list_destroy(pooled, NULL);
+  list_destroy(other, NULL);
+  list_remove(plain, 0);
+  list_destroy(plain, NULL);
+}
+
+void test_node_pool_internal_nodes(void) {
+  ListType types[] = {LIST_UNROLLED, LIST_TREE, LIST_ARRAY};
+  ListAllocator allocator = {.pool_slab_nodes = 16};
+  int values[300];
+
+  for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+    List *list = list_create_with_allocator(types[t], &allocator);
+    List *expected = list_create(LIST_ARRAY);
+    List *other = list_create_with_allocator(types[t], &allocator);
+
+    // Churn through inserts and removes so blocks get recycled
+    for (int i = 0; i < 300; i++) {
+      values[i] = i;
+      size_t index = ((size_t)i * 31) % (list_size(list) + 1);
+      list_insert(list, index, &values[i]);
+      list_insert(expected, index, &values[i]);
+      if (i % 4 == 3) {
+        index = ((size_t)i * 17) % list_size(list);
+        TEST_ASSERT_EQUAL_PTR(list_remove(expected, index),
+                              list_remove(list, index));
+      }
+    }
+
+    // Moving elements between lists with separate pools stays correct
+    list_append(other, &values[0]);
+    TEST_ASSERT_TRUE(list_concat(other, list));
+    TEST_ASSERT_TRUE(list_splice(list, 0, other));
+    TEST_ASSERT_EQUAL_PTR(&values[0], list_remove(list, 0));
+
+    TEST_ASSERT_EQUAL(list_size(expected), list_size(list));
+    for (size_t i = 0; i < list_size(list); i++)
+      TEST_ASSERT_EQUAL_PTR(list_get(expected, i), list_get(list, i));
+
+    // Cleanup (elements live on the stack)
+    list_destroy(list, NULL);
+    list_destroy(other, NULL);
+    list_destroy(expected, NULL);
+  }
+}
+
+void test_create_destroy_throughput(void) {
+  const size_t count = 200000;
+  Node node = {NODE, NULL, NULL};
+
+  // Short-lived lists: create, touch, destroy
+  double start = now_seconds();
+  for (size_t i = 0; i < count; i++) {
+    List *list = list_create(LIST_LINKED_SENTINEL);
+    list_append(list, &node);
+    TEST_ASSERT_EQUAL_PTR(&node, list_remove(list, 0));
+    list_destroy(list, NULL);
+  }
+  double elapsed = now_seconds() - start;
+
+  printf("\ncreate/destroy x%zu: %.3f ms (%.2f M lists/s)\n", count,
+         elapsed * 1e3, (double)count / elapsed / 1e6);
+}
+
+void test_list_init_caller_storage(void) {
+  Node nodes[40];
+  ListStorage storage;
+  List *list = (List *)&storage;
+
+  TEST_ASSERT_TRUE(sizeof(List) <= sizeof(ListStorage));
+  TEST_ASSERT_FALSE(list_init(NULL, LIST_ARRAY));
+
+  // The same storage is reused for every type
+  for (size_t t = 0; t < sequential_type_count; t++) {
+    ListType type = sequential_types[t];
+    TEST_ASSERT_TRUE(list_init(list, type));
+    TEST_ASSERT_TRUE(list_is_empty(list));
+
+    for (int i = 0; i < 40; i++) {
+      nodes[i].type = NODE;
+      TEST_ASSERT_TRUE(list_insert(list, (size_t)i / 2, &nodes[i]));
+    }
+    TEST_ASSERT_EQUAL(40, list_size(list));
+    TEST_ASSERT_EQUAL_PTR(&nodes[1], list_get(list, 0));
+    TEST_ASSERT_EQUAL_PTR(&nodes[1], list_remove(list, 0));
+
+    // Splitting an in-place list hands back a heap list
+    List *suffix = list_split_at(list, 20);
+    TEST_ASSERT_NOT_NULL(suffix);
+    TEST_ASSERT_EQUAL(19, list_size(suffix));
+    TEST_ASSERT_TRUE(list_concat(list, suffix));
+    list_destroy(suffix, NULL);
+
+    // Elements live on the stack
+    list_deinit(list, NULL);
+  }
+}
+
+typedef struct CountingAllocator {
+  size_t allocs, frees;
+  size_t limit; // allocations that succeed (0: no limit)
+} CountingAllocator;
+
+static void *counting_alloc(void *ctx, size_t size) {
+  CountingAllocator *counts = ctx;
+  if (counts->limit > 0 && counts->allocs >= counts->limit)
+    return NULL;
+  counts->allocs++;
+  return malloc(size);
+}
+
+static void counting_free(void *ctx, void *ptr) {
+  ((CountingAllocator *)ctx)->frees++;
+  free(ptr);
+}
+
+void test_allocator_hooks_all_types(void) {
+  int values[200];
+
+  for (size_t pooled = 0; pooled < 2; pooled++) {
+    for (size_t t = 0; t < sequential_type_count; t++) {
+      ListType type = sequential_types[t];
+      CountingAllocator counts = {0, 0, 0};
+      ListAllocator allocator = {.pool_slab_nodes = pooled ? 8 : 0,
+                                 .alloc = counting_alloc,
+                                 .free = counting_free,
+                                 .ctx = &counts};
+      List *list = list_create_with_allocator(type, &allocator);
+      TEST_ASSERT_NOT_NULL(list);
+
+      for (int i = 0; i < 200; i++) {
+        values[i] = i;
+        void *item = &values[i];
+        if (type == LIST_LINKED_SENTINEL) {
+          item = list_node_alloc(list);
+          TEST_ASSERT_NOT_NULL(item);
+        }
+        list_insert(list, ((size_t)i * 7) % (list_size(list) + 1), item);
+      }
+
+      // Lists made from this one (split, create_like) inherit the hooks
+      List *suffix = list_split_at(list, 50);
+      TEST_ASSERT_NOT_NULL(suffix);
+      TEST_ASSERT_EQUAL(150, list_size(suffix));
+      for (int i = 0; i < 20; i++) {
+        void *item = list_remove(suffix, 0);
+        if (type == LIST_LINKED_SENTINEL)
+          list_node_free(suffix, item);
+      }
+      TEST_ASSERT_TRUE(list_concat(list, suffix));
+      TEST_ASSERT_GREATER_THAN(0, counts.allocs);
+
+      // Hand element nodes back through the list so the hooks see them
+      list_destroy(suffix, NULL);
+      while (type == LIST_LINKED_SENTINEL && !list_is_empty(list))
+        list_node_free(list, list_remove(list, 0));
+      list_destroy(list, NULL);
+      TEST_ASSERT_EQUAL(counts.allocs, counts.frees);
+    }
+  }
+}
+
+void test_batch_allocation_failure(void) {
+  ListType types[] = {LIST_UNROLLED, LIST_SKIP, LIST_TREE};
+  int values[100];
+  void *items[100];
+  for (int i = 0; i < 100; i++) {
+    values[i] = i;
+    items[i] = &values[i];
+  }
+
+  for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+    CountingAllocator counts = {0, 0, 0};
+    ListAllocator allocator = {
+        .alloc = counting_alloc, .free = counting_free, .ctx = &counts};
+    List *list = list_create_with_allocator(types[t], &allocator);
+    TEST_ASSERT_TRUE(list_append_many(list, items, 10));
+
+    // Running out of memory part way inserts nothing
+    counts.limit = counts.allocs + 1;
+    TEST_ASSERT_FALSE(list_insert_many(list, 5, &items[10], 90));
+    TEST_ASSERT_EQUAL(10, list_size(list));
+    for (size_t i = 0; i < 10; i++)
+      TEST_ASSERT_EQUAL_PTR(items[i], list_get(list, i));
+
+    // A splice that runs out part way hands the moved elements back
+    List *donor = list_create(types[t]);
+    TEST_ASSERT_TRUE(list_append_many(donor, &items[10], 90));
+    TEST_ASSERT_FALSE(list_splice(list, 5, donor));
+    TEST_ASSERT_EQUAL(10, list_size(list));
+    TEST_ASSERT_EQUAL(90, list_size(donor));
+    for (size_t i = 0; i < 90; i++)
+      TEST_ASSERT_EQUAL_PTR(items[10 + i], list_get(donor, i));
+    list_destroy(donor, NULL);
+
+    counts.limit = 0;
+    TEST_ASSERT_TRUE(list_insert_many(list, 5, &items[10], 90));
+    TEST_ASSERT_EQUAL(100, list_size(list));
+    list_destroy(list, NULL);
+    TEST_ASSERT_EQUAL(counts.allocs, counts.frees);
+  }
+}
+
+void test_unrolled_splice_allocators(void) {
+  int values[300];
+  for (int i = 0; i < 300; i++)
+    values[i] = i;
+
+  for (size_t shared = 0; shared < 2; shared++) {
+    CountingAllocator dstCounts = {0, 0, 0}, srcCounts = {0, 0, 0};
+    ListAllocator dstAllocator = {.alloc = counting_alloc,
+                                  .free = counting_free,
+                                  .ctx = &dstCounts};
+    ListAllocator srcAllocator = dstAllocator;
+    if (!shared)
+      srcAllocator.ctx = &srcCounts;
+    List *dst = list_create_with_allocator(LIST_UNROLLED, &dstAllocator);
+    List *src = list_create_with_allocator(LIST_UNROLLED, &srcAllocator);
+    for (int i = 0; i < 100; i++)
+      TEST_ASSERT_TRUE(list_append(dst, &values[i]));
+    for (int i = 100; i < 300; i++)
+      TEST_ASSERT_TRUE(list_append(src, &values[i]));
+
+    // Blocks are only relinked when dst may free them (splitting the block
+    // at the index takes at most one more)
+    size_t allocs = dstCounts.allocs;
+    TEST_ASSERT_TRUE(list_splice(dst, 50, src));
+    if (shared)
+      TEST_ASSERT_LESS_OR_EQUAL(allocs + 1, dstCounts.allocs);
+    TEST_ASSERT_TRUE(list_is_empty(src));
+    TEST_ASSERT_EQUAL(300, list_size(dst));
+    for (size_t i = 0; i < 300; i++) {
+      int expected = (i < 50) ? (int)i : (i < 250) ? (int)i + 50 : (int)i - 200;
+      TEST_ASSERT_EQUAL_INT(expected, *(int *)list_get(dst, i));
+    }
+
+    // Each allocator gets back exactly what it handed out
+    list_destroy(src, NULL);
+    TEST_ASSERT_EQUAL(srcCounts.allocs, srcCounts.frees);
+    list_destroy(dst, NULL);
+    TEST_ASSERT_EQUAL(dstCounts.allocs, dstCounts.frees);
+  }
+}
+
+void test_list_clear_all_types(void) {
+  Node nodes[60];
+
+  for (size_t pooled = 0; pooled < 2; pooled++) {
+    for (size_t t = 0; t < sequential_type_count; t++) {
+      ListType type = sequential_types[t];
+      CountingAllocator counts = {0, 0, 0};
+      ListAllocator allocator = {.pool_slab_nodes = pooled ? 8 : 0,
+                                 .alloc = counting_alloc,
+                                 .free = counting_free,
+                                 .ctx = &counts};
+      List *list = list_create_with_allocator(type, &allocator);
+      size_t allocsAfterFirstFill = 0;
+
+      for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 60; i++) {
+          nodes[i].type = NODE;
+          void *item = &nodes[i];
+          if (type == LIST_LINKED_SENTINEL && pooled)
+            item = list_node_alloc(list);
+          TEST_ASSERT_TRUE(list_insert(list, (size_t)i / 3, item));
+        }
+        TEST_ASSERT_EQUAL(60, list_size(list));
+        if (type != LIST_LINKED_SENTINEL || !pooled)
+          TEST_ASSERT_EQUAL_PTR(&nodes[2], list_get(list, 0));
+
+        // Pooled nodes come back wholesale: refills reuse the same slabs
+        if (round == 0)
+          allocsAfterFirstFill = counts.allocs;
+        else if (pooled && type != LIST_ARRAY &&
+                 type != LIST_GAP_BUFFER && type != LIST_SKIP)
+          TEST_ASSERT_EQUAL(allocsAfterFirstFill, counts.allocs);
+
+        list_clear(list, NULL);
+        TEST_ASSERT_TRUE(list_is_empty(list));
+        TEST_ASSERT_NULL(list_get(list, 0));
+        ListIter iter = iter_begin(list);
+        TEST_ASSERT_NULL(iter_get(&iter));
+      }
+
+      list_destroy(list, NULL);
+      TEST_ASSERT_EQUAL(counts.allocs, counts.frees);
+    }
+  }
+}
+
+void test_push_pop_peek_all_types(void) {
+  ListType types[] = {LIST_LINKED_SENTINEL, LIST_ARRAY, LIST_GAP_BUFFER,
+                      LIST_UNROLLED,        LIST_SKIP,  LIST_TREE,
+                      LIST_CONCURRENT,      LIST_RCU,   LIST_SHARDED,
+                      LIST_BOUNDED};
+  Node nodes[100];
+  // Expected contents, centred so pushes at either end fit
+  void *model[200];
+
+  for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+    List *list = list_create(types[t]);
+    size_t first = 100, last = 100;
+    TEST_ASSERT_NULL(list_peek_front(list));
+    TEST_ASSERT_NULL(list_peek_back(list));
+    TEST_ASSERT_NULL(list_pop_front(list));
+    TEST_ASSERT_NULL(list_pop_back(list));
+
+    for (int i = 0; i < 100; i++) {
+      nodes[i].type = NODE;
+      if (i % 3 == 0) {
+        TEST_ASSERT_TRUE(list_push_front(list, &nodes[i]));
+        model[--first] = &nodes[i];
+      } else {
+        TEST_ASSERT_TRUE(list_push_back(list, &nodes[i]));
+        model[last++] = &nodes[i];
+      }
+      TEST_ASSERT_EQUAL_PTR(model[first], list_peek_front(list));
+      TEST_ASSERT_EQUAL_PTR(model[last - 1], list_peek_back(list));
+    }
+    TEST_ASSERT_EQUAL(100, list_size(list));
+    for (size_t i = first; i < last; i += 7)
+      TEST_ASSERT_EQUAL_PTR(model[i], list_get(list, i - first));
+
+    // Drain from both ends, checking the far end stays put
+    for (int i = 0; first < last; i++) {
+      if (i % 2 == 0)
+        TEST_ASSERT_EQUAL_PTR(model[first++], list_pop_front(list));
+      else
+        TEST_ASSERT_EQUAL_PTR(model[--last], list_pop_back(list));
+      TEST_ASSERT_EQUAL(last - first, list_size(list));
+      if (first < last) {
+        TEST_ASSERT_EQUAL_PTR(model[first], list_peek_front(list));
+        TEST_ASSERT_EQUAL_PTR(model[last - 1], list_peek_back(list));
+      }
+    }
+    TEST_ASSERT_TRUE(list_is_empty(list));
+    TEST_ASSERT_NULL(list_peek_front(list));
+    TEST_ASSERT_NULL(list_pop_back(list));
+    list_destroy(list, NULL);
+  }
+
+  // The queue and the deque each work one way round
+  List *queue = list_create(LIST_MPSC);
+  List *deque = list_create(LIST_DEQUE_LOCKFREE);
+  for (int i = 0; i < 10; i++) {
+    nodes[i].type = NODE;
+    TEST_ASSERT_TRUE(list_push_back(queue, &nodes[i]));
+    TEST_ASSERT_TRUE(list_push_back(deque, &nodes[i]));
+  }
+  TEST_ASSERT_FALSE(list_push_front(queue, &nodes[10]));
+  TEST_ASSERT_FALSE(list_push_front(deque, &nodes[10]));
+  TEST_ASSERT_NULL(list_pop_back(queue));
+  TEST_ASSERT_EQUAL_PTR(&nodes[0], list_peek_front(queue));
+  TEST_ASSERT_EQUAL_PTR(&nodes[9], list_peek_back(queue));
+  TEST_ASSERT_EQUAL_PTR(&nodes[0], list_peek_front(deque));
+  TEST_ASSERT_EQUAL_PTR(&nodes[9], list_peek_back(deque));
+  TEST_ASSERT_EQUAL_PTR(&nodes[0], list_pop_front(queue));
+  TEST_ASSERT_EQUAL_PTR(&nodes[0], list_pop_front(deque));
+  TEST_ASSERT_EQUAL_PTR(&nodes[9], list_pop_back(deque));
+  for (int i = 1; i < 10; i++)
+    TEST_ASSERT_EQUAL_PTR(&nodes[i], list_pop_front(queue));
+  TEST_ASSERT_NULL(list_peek_front(queue));
+  TEST_ASSERT_NULL(list_peek_back(queue));
+  TEST_ASSERT_EQUAL_PTR(&nodes[8], list_peek_back(deque));
+  list_destroy(queue, NULL);
+  list_destroy(deque, NULL);
+}
+
+#define CONCURRENT_WRITERS 4
+#define CONCURRENT_READERS 2
+#define CONCURRENT_PER_WRITER 2000
+
+typedef struct ConcurrentWork {
+  List *list;
+  Node *nodes;
+  size_t reads;
+} ConcurrentWork;
+
+static void *concurrent_writer(void *arg) {
+  ConcurrentWork *work = arg;
+  for (size_t i = 0; i < CONCURRENT_PER_WRITER; i++) {
+    work->nodes[i].type = NODE;
+    // Mix appends with front inserts and a few removes
+    if (i % 3 == 0)
+      list_insert(work->list, 0, &work->nodes[i]);
+    else
+      list_append(work->list, &work->nodes[i]);
+    if (i % 10 == 9) {
+      // Unity asserts can't run off the main thread: checked after joining
+      Node *removed = list_remove(work->list, 0);
+      if (removed)
+        list_append(work->list, removed); // put it back at the end
+    }
+  }
+  return NULL;
+}
+
+static void *concurrent_reader(void *arg) {
+  ConcurrentWork *work = arg;
+  for (size_t i = 0; i < 4000; i++) {
+    size_t size = list_size(work->list);
+    // Sizes only grow, so an index below an earlier size stays valid
+    if (size > 0 && list_get(work->list, (i * 7919) % size))
+      work->reads += 1;
+  }
+  return NULL;
+}
+
+void test_concurrent_list_threads(void) {
+  List *list = list_create(LIST_CONCURRENT);
+  TEST_ASSERT_NOT_NULL(list);
+  Node *nodes =
+      calloc(CONCURRENT_WRITERS * CONCURRENT_PER_WRITER, sizeof(Node));
+  pthread_t threads[CONCURRENT_WRITERS + CONCURRENT_READERS];
+  ConcurrentWork work[CONCURRENT_WRITERS + CONCURRENT_READERS];
+
+  // Non-nodes are still rejected
+  Node bad = {SENTINEL + 1, NULL, NULL};
+  TEST_ASSERT_FALSE(list_append(list, &bad));
+
+  for (size_t i = 0; i < CONCURRENT_WRITERS + CONCURRENT_READERS; i++) {
+    work[i].list = list;
+    work[i].nodes = &nodes[i * CONCURRENT_PER_WRITER];
+    work[i].reads = 0;
+    pthread_create(&threads[i], NULL,
+                   (i < CONCURRENT_WRITERS) ? concurrent_writer
+                                            : concurrent_reader,
+                   &work[i]);
+  }
+  for (size_t i = 0; i < CONCURRENT_WRITERS + CONCURRENT_READERS; i++)
+    pthread_join(threads[i], NULL);
+
+  // Every node made it in exactly once
+  size_t total = CONCURRENT_WRITERS * CONCURRENT_PER_WRITER;
+  TEST_ASSERT_EQUAL(total, list_size(list));
+  size_t seen = 0;
+  ListIter iter = iter_begin(list);
+  for (void *item = iter_get(&iter); item; item = iter_get(&iter)) {
+    Node *node = item;
+    TEST_ASSERT_TRUE(node >= nodes && node < nodes + total);
+    TEST_ASSERT_EQUAL(NODE, node->type);
+    node->type = SENTINEL; // mark as seen
+    seen += 1;
+    iter_next(&iter);
+  }
+  TEST_ASSERT_EQUAL(total, seen);
+  for (size_t i = 0; i < total; i++)
+    nodes[i].type = NODE;
+
+  // Batch and whole-list edits work under the locks as well
+  List *suffix = list_split_at(list, total / 2);
+  TEST_ASSERT_NOT_NULL(suffix);
+  TEST_ASSERT_EQUAL(total / 2, list_size(suffix));
+  TEST_ASSERT_TRUE(list_concat(list, suffix));
+  TEST_ASSERT_TRUE(list_is_empty(suffix));
+  TEST_ASSERT_EQUAL(total, list_size(list));
+  TEST_ASSERT_NULL(list_get(list, total));
+
+  list_clear(list, NULL);
+  TEST_ASSERT_TRUE(list_is_empty(list));
+  void *items[2] = {&nodes[0], &nodes[1]};
+  TEST_ASSERT_TRUE(list_append_many(list, items, 2));
+  TEST_ASSERT_EQUAL_PTR(&nodes[1], list_get(list, 1));
+
+  // Cleanup (nodes are owned by the test)
+  list_destroy(suffix, NULL);
+  list_destroy(list, NULL);
+  free(nodes);
+}
+
+#define RCU_READERS 3
+#define RCU_ROUTES 32
+#define RCU_SPARES 8
+#define RCU_REWRITES 100
+
+typedef struct RcuRoute {
+  Node node; // first, so a Node pointer is a route pointer
+  size_t live;
+} RcuRoute;
+
+typedef struct RcuWork {
+  List *list;
+  bool *done;
+  size_t started, reads, stale;
+  void *removed;
+} RcuWork;
+
+static void *rcu_reader(void *arg) {
+  RcuWork *work = arg;
+  while (!__atomic_load_n(work->done, __ATOMIC_ACQUIRE)) {
+    size_t token = list_rcu_read_lock(work->list);
+    ListIter iter = iter_begin(work->list);
+    for (void *item = iter_get(&iter); item; item = iter_get(&iter)) {
+      // A route handed back to the writer while we can see it is stale
+      RcuRoute *route = item;
+      if (!__atomic_load_n(&route->live, __ATOMIC_RELAXED))
+        work->stale += 1;
+      work->reads += 1;
+      iter_next(&iter);
+    }
+    RcuRoute *first = list_peek_front(work->list);
+    if (first && !__atomic_load_n(&first->live, __ATOMIC_RELAXED))
+      work->stale += 1;
+    list_rcu_read_unlock(work->list, token);
+    __atomic_store_n(&work->started, 1, __ATOMIC_RELEASE);
+  }
+  return NULL;
+}
+
+static void *rcu_remover(void *arg) {
+  RcuWork *work = arg;
+  __atomic_store_n(&work->removed, list_remove(work->list, 0),
+                   __ATOMIC_RELEASE);
+  return NULL;
+}
+
+void test_rcu_list_readers_threads(void) {
+  List *list = list_create(LIST_RCU);
+  TEST_ASSERT_NOT_NULL(list);
+  // Routes past RCU_ROUTES start out retired, waiting to be swapped in
+  RcuRoute routes[RCU_ROUTES + RCU_SPARES];
+  RcuRoute *spares[RCU_SPARES];
+  for (size_t i = 0; i < RCU_ROUTES + RCU_SPARES; i++) {
+    routes[i].node.type = NODE;
+    routes[i].live = (i < RCU_ROUTES);
+    if (i < RCU_ROUTES)
+      TEST_ASSERT_TRUE(list_append(list, &routes[i]));
+    else
+      spares[i - RCU_ROUTES] = &routes[i];
+  }
+
+  // Non-nodes are rejected; cursors and splits are for other types
+  Node bad = {SENTINEL + 1, NULL, NULL};
+  TEST_ASSERT_FALSE(list_append(list, &bad));
+  ListIter iter = iter_begin(list);
+  TEST_ASSERT_TRUE(iter_next(&iter));
+  TEST_ASSERT_EQUAL_PTR(&routes[1], iter_get(&iter));
+  TEST_ASSERT_FALSE(iter_prev(&iter));
+  TEST_ASSERT_FALSE(iter_insert(&iter, &bad));
+  TEST_ASSERT_NULL(iter_remove(&iter));
+  TEST_ASSERT_NULL(list_split_at(list, 1));
+  TEST_ASSERT_EQUAL_PTR(&routes[5], list_get(list, 5));
+  TEST_ASSERT_NULL(list_get(list, RCU_ROUTES));
+
+  // A removal waits for the read-side sections that may still see the node
+  bool done = false;
+  pthread_t remover;
+  RcuWork removal = {list, &done, 0, 0, 0, NULL};
+  size_t token = list_rcu_read_lock(list);
+  RcuRoute *head = list_peek_front(list);
+  pthread_create(&remover, NULL, rcu_remover, &removal);
+  struct timespec pause = {0, 1000000};
+  for (int i = 0; i < 20; i++)
+    nanosleep(&pause, NULL);
+  TEST_ASSERT_NULL(__atomic_load_n(&removal.removed, __ATOMIC_ACQUIRE));
+  TEST_ASSERT_EQUAL_PTR(&routes[1], list_get(list, 0)); // already unlinked
+  TEST_ASSERT_EQUAL_PTR(&routes[0], head);
+  list_rcu_read_unlock(list, token);
+  pthread_join(remover, NULL);
+  TEST_ASSERT_EQUAL_PTR(&routes[0], removal.removed);
+  TEST_ASSERT_TRUE(list_push_front(list, &routes[0]));
+
+  pthread_t threads[RCU_READERS];
+  RcuWork work[RCU_READERS];
+  for (size_t i = 0; i < RCU_READERS; i++) {
+    work[i] = (RcuWork){list, &done, 0, 0, 0, NULL};
+    pthread_create(&threads[i], NULL, rcu_reader, &work[i]);
+  }
+  // Let every reader get going before the writer starts
+  for (size_t i = 0; i < RCU_READERS; i++) {
+    while (!__atomic_load_n(&work[i].started, __ATOMIC_ACQUIRE))
+      nanosleep(&pause, NULL);
+  }
+
+  // Swap routes: each removed one is retired (and stays so for a while) as
+  // soon as list_remove returns
+  for (size_t i = 0; i < RCU_REWRITES; i++) {
+    RcuRoute *route = list_remove(list, (i * 7) % RCU_ROUTES);
+    TEST_ASSERT_NOT_NULL(route);
+    __atomic_store_n(&route->live, 0, __ATOMIC_RELAXED);
+    RcuRoute *spare = spares[i % RCU_SPARES];
+    spares[i % RCU_SPARES] = route;
+    __atomic_store_n(&spare->live, 1, __ATOMIC_RELAXED);
+    if (i % 2 == 0)
+      TEST_ASSERT_TRUE(list_insert(list, (i * 3) % RCU_ROUTES, spare));
+    else
+      TEST_ASSERT_TRUE(list_push_front(list, spare));
+  }
+  __atomic_store_n(&done, true, __ATOMIC_RELEASE);
+
+  size_t reads = 0, stale = 0;
+  for (size_t i = 0; i < RCU_READERS; i++) {
+    pthread_join(threads[i], NULL);
+    reads += work[i].reads;
+    stale += work[i].stale;
+  }
+  TEST_ASSERT_EQUAL(0, stale);
+  TEST_ASSERT_TRUE(reads > 0);
+  TEST_ASSERT_EQUAL(RCU_ROUTES, list_size(list));
+
+  // Batches are published whole; clear hands every node back
+  RcuRoute *last = list_pop_back(list);
+  RcuRoute *first = list_pop_front(list);
+  void *items[2] = {first, last};
+  TEST_ASSERT_TRUE(list_append_many(list, items, 2));
+  TEST_ASSERT_EQUAL_PTR(last, list_peek_back(list));
+  TEST_ASSERT_EQUAL_PTR(first, list_get(list, RCU_ROUTES - 2));
+  list_clear(list, NULL);
+  TEST_ASSERT_TRUE(list_is_empty(list));
+  TEST_ASSERT_NULL(list_peek_front(list));
+  TEST_ASSERT_NULL(list_pop_back(list));
+  list_destroy(list, NULL);
+}
+
+// Called by RCU readers between reading the grace-period phase and counting
+// themselves in it (TEST builds only)
+extern void (*rcu_list_read_stall)(void);
+
+typedef struct RcuStall {
+  List *list;
+  int step;         // 1: stalled in the hook, 2: released, 3: holding a node
+  bool reader_done; // set just before the held node's section ends
+  bool freed_in_use;
+  void *held, *removed;
+} RcuStall;
+
+static RcuStall rcu_stall;
+
+static void rcu_stall_reader(void) {
+  // Only the first section stalls
+  if (__atomic_load_n(&rcu_stall.step, __ATOMIC_ACQUIRE) != 0)
+    return;
+  __atomic_store_n(&rcu_stall.step, 1, __ATOMIC_RELEASE);
+  struct timespec pause = {0, 1000000};
+  while (__atomic_load_n(&rcu_stall.step, __ATOMIC_ACQUIRE) != 2)
+    nanosleep(&pause, NULL);
+}
+
+static void *rcu_delayed_reader(void *arg) {
+  (void)arg;
+  size_t token = list_rcu_read_lock(rcu_stall.list);
+  rcu_stall.held = list_peek_front(rcu_stall.list);
+  __atomic_store_n(&rcu_stall.step, 3, __ATOMIC_RELEASE);
+  // Give the writer every chance to hand the held node back early
+  struct timespec pause = {0, 1000000};
+  for (int i = 0; i < 20; i++)
+    nanosleep(&pause, NULL);
+  __atomic_store_n(&rcu_stall.reader_done, true, __ATOMIC_RELEASE);
+  list_rcu_read_unlock(rcu_stall.list, token);
+  return NULL;
+}
+
+static void *rcu_delayed_remover(void *arg) {
+  (void)arg;
+  rcu_stall.removed = list_remove(rcu_stall.list, 0);
+  rcu_stall.freed_in_use =
+      !__atomic_load_n(&rcu_stall.reader_done, __ATOMIC_ACQUIRE);
+  return NULL;
+}
+
+void test_rcu_list_delayed_reader(void) {
+  // A reader reads the phase, then stalls while a whole grace period passes
+  // before it counts itself in. The next grace period must still wait for it.
+  List *list = list_create(LIST_RCU);
+  RcuRoute routes[2];
+  for (size_t i = 0; i < 2; i++) {
+    routes[i].node.type = NODE;
+    TEST_ASSERT_TRUE(list_append(list, &routes[i]));
+  }
+  rcu_stall = (RcuStall){list, 0, false, false, NULL, NULL};
+  rcu_list_read_stall = rcu_stall_reader;
+
+  pthread_t reader, remover;
+  struct timespec pause = {0, 1000000};
+  pthread_create(&reader, NULL, rcu_delayed_reader, NULL);
+  while (__atomic_load_n(&rcu_stall.step, __ATOMIC_ACQUIRE) != 1)
+    nanosleep(&pause, NULL);
+  TEST_ASSERT_EQUAL_PTR(&routes[0], list_remove(list, 0));
+
+  __atomic_store_n(&rcu_stall.step, 2, __ATOMIC_RELEASE);
+  while (__atomic_load_n(&rcu_stall.step, __ATOMIC_ACQUIRE) != 3)
+    nanosleep(&pause, NULL);
+  TEST_ASSERT_EQUAL_PTR(&routes[1], rcu_stall.held);
+  pthread_create(&remover, NULL, rcu_delayed_remover, NULL);
+  pthread_join(reader, NULL);
+  pthread_join(remover, NULL);
+  rcu_list_read_stall = NULL;
+
+  TEST_ASSERT_EQUAL_PTR(&routes[1], rcu_stall.removed);
+  TEST_ASSERT_FALSE(rcu_stall.freed_in_use);
+  TEST_ASSERT_TRUE(list_is_empty(list));
+  list_destroy(list, NULL);
+}
+
+#define SHARDED_WRITERS 4
+#define SHARDED_PER_WRITER 3000
+
+static void *sharded_writer(void *arg) {
+  ConcurrentWork *work = arg;
+  for (size_t i = 0; i < SHARDED_PER_WRITER;) {
+    // Mix single appends with small batches
+    if (i % 10 == 0 && i + 4 <= SHARDED_PER_WRITER) {
+      void *batch[4];
+      for (size_t j = 0; j < 4; j++)
+        batch[j] = &work->nodes[i + j];
+      list_append_many(work->list, batch, 4);
+      i += 4;
+    } else {
+      list_append(work->list, &work->nodes[i]);
+      i += 1;
+    }
+  }
+  return NULL;
+}
+
+static void *sharded_reader(void *arg) {
+  ConcurrentWork *work = arg;
+  for (size_t i = 0; i < 500; i++) {
+    // Each lookup gathers the shards while the writers keep appending
+    size_t size = list_size(work->list);
+    if (size > 0 && list_get(work->list, (i * 7919) % size))
+      work->reads += 1;
+  }
+  return NULL;
+}
+
+typedef struct ShardedTurn {
+  List *list;
+  Node *nodes;
+  size_t round, *turn;
+} ShardedTurn;
+
+static void *sharded_append_in_turn(void *arg) {
+  ShardedTurn *work = arg;
+  while (__atomic_load_n(work->turn, __ATOMIC_ACQUIRE) != work->round)
+    sched_yield();
+  for (size_t i = 0; i < 3; i++)
+    list_append(work->list, &work->nodes[i]);
+  __atomic_store_n(work->turn, work->round + 1, __ATOMIC_RELEASE);
+  return NULL;
+}
+
+void test_sharded_list_threads(void) {
+  size_t total = SHARDED_WRITERS * SHARDED_PER_WRITER;
+  Node *nodes = calloc(total, sizeof(Node));
+
+  for (int ordered = 0; ordered < 2; ordered++) {
+    List *list = list_create_sharded(4, ordered);
+    TEST_ASSERT_NOT_NULL(list);
+    for (size_t i = 0; i < total; i++)
+      nodes[i].type = NODE;
+
+    pthread_t threads[SHARDED_WRITERS + 1];
+    ConcurrentWork work[SHARDED_WRITERS + 1];
+    for (size_t i = 0; i <= SHARDED_WRITERS; i++) {
+      work[i] = (ConcurrentWork){list, &nodes[i * SHARDED_PER_WRITER], 0};
+      pthread_create(&threads[i], NULL,
+                     (i < SHARDED_WRITERS) ? sharded_writer : sharded_reader,
+                     &work[i]);
+    }
+    for (size_t i = 0; i <= SHARDED_WRITERS; i++)
+      pthread_join(threads[i], NULL);
+    TEST_ASSERT_EQUAL(total, list_size(list));
+
+    // Every node made it in once, and each writer's appends kept their order
+    size_t last[SHARDED_WRITERS], seen = 0;
+    for (size_t i = 0; i < SHARDED_WRITERS; i++)
+      last[i] = SIZE_MAX;
+    ListIter iter = iter_begin(list);
+    for (void *item = iter_get(&iter); item; item = iter_get(&iter)) {
+      size_t offset = (size_t)((Node *)item - nodes);
+      size_t writer = offset / SHARDED_PER_WRITER;
+      TEST_ASSERT_TRUE(offset < total);
+      TEST_ASSERT_TRUE(last[writer] == SIZE_MAX ||
+                       offset % SHARDED_PER_WRITER > last[writer]);
+      last[writer] = offset % SHARDED_PER_WRITER;
+      seen += 1;
+      iter_next(&iter);
+    }
+    TEST_ASSERT_EQUAL(total, seen);
+
+    // Positional edits, splits and concatenation work on the gathered list
+    Node *second = list_get(list, 1);
+    TEST_ASSERT_EQUAL_PTR(second, list_remove(list, 1));
+    List *suffix = list_split_at(list, total / 2);
+    TEST_ASSERT_NOT_NULL(suffix);
+    TEST_ASSERT_EQUAL(total - 1 - total / 2, list_size(suffix));
+    TEST_ASSERT_TRUE(list_append(suffix, second));
+    TEST_ASSERT_TRUE(list_concat(list, suffix));
+    TEST_ASSERT_TRUE(list_is_empty(suffix));
+    TEST_ASSERT_EQUAL(total, list_size(list));
+    TEST_ASSERT_EQUAL_PTR(second, list_peek_back(list));
+    list_destroy(suffix, NULL);
+    list_destroy(list, NULL);
+  }
+
+  // Ordered lists keep the global append order across threads (all alive at
+  // once, so spread over shards) taking turns
+  List *list = list_create_sharded(4, true);
+  pthread_t threads[8];
+  ShardedTurn turns[8];
+  size_t turn = 0;
+  for (size_t round = 0; round < 8; round++) {
+    for (size_t i = 0; i < 3; i++)
+      nodes[round * 3 + i].type = NODE;
+    turns[round] = (ShardedTurn){list, &nodes[round * 3], round, &turn};
+    pthread_create(&threads[round], NULL, sharded_append_in_turn,
+                   &turns[round]);
+  }
+  for (size_t round = 0; round < 8; round++)
+    pthread_join(threads[round], NULL);
+  TEST_ASSERT_EQUAL(24, list_size(list));
+  for (size_t i = 0; i < 24; i++)
+    TEST_ASSERT_EQUAL_PTR(&nodes[i], list_get(list, i));
+  list_destroy(list, NULL);
+  free(nodes);
+}
+
+#define BOUNDED_PRODUCERS 3
+#define BOUNDED_PER_PRODUCER 4000
+#define BOUNDED_CAPACITY 16
+
+typedef struct BoundedWork {
+  List *list;
+  Node *nodes;
+  size_t count;
+  bool done;
+  void *popped;
+} BoundedWork;
+
+static void *bounded_producer(void *arg) {
+  BoundedWork *work = arg;
+  for (size_t i = 0; i < work->count; i++)
+    list_push_back_wait(work->list, &work->nodes[i]);
+  __atomic_store_n(&work->done, true, __ATOMIC_RELEASE);
+  return NULL;
+}
+
+// Pushes one node, recording in `done` whether it made it before the timeout
+static void *bounded_timed_producer(void *arg) {
+  BoundedWork *work = arg;
+  bool pushed = list_push_back_timed(work->list, work->nodes, 2000);
+  __atomic_store_n(&work->done, pushed, __ATOMIC_RELEASE);
+  return NULL;
+}
+
+static void *bounded_consumer(void *arg) {
+  BoundedWork *work = arg;
+  work->popped = list_pop_front_wait(work->list);
+  __atomic_store_n(&work->done, true, __ATOMIC_RELEASE);
+  return NULL;
+}
+
+void test_bounded_queue_threads(void) {
+  size_t total = BOUNDED_PRODUCERS * BOUNDED_PER_PRODUCER;
+  Node *nodes = calloc(total, sizeof(Node));
+  for (size_t i = 0; i < total; i++)
+    nodes[i].type = NODE;
+  TEST_ASSERT_NULL(list_create_bounded(0));
+
+  // Producers block on the full queue while this thread drains it, so the
+  // queue never grows past its capacity and each producer's order holds
+  List *list = list_create_bounded(BOUNDED_CAPACITY);
+  TEST_ASSERT_NOT_NULL(list);
+  pthread_t threads[BOUNDED_PRODUCERS];
+  BoundedWork work[BOUNDED_PRODUCERS];
+  for (size_t i = 0; i < BOUNDED_PRODUCERS; i++) {
+    work[i] = (BoundedWork){list, &nodes[i * BOUNDED_PER_PRODUCER],
+                            BOUNDED_PER_PRODUCER, false, NULL};
+    pthread_create(&threads[i], NULL, bounded_producer, &work[i]);
+  }
+  size_t last[BOUNDED_PRODUCERS];
+  for (size_t i = 0; i < BOUNDED_PRODUCERS; i++)
+    last[i] = SIZE_MAX;
+  for (size_t popped = 0; popped < total; popped++) {
+    TEST_ASSERT_TRUE(list_size(list) <= BOUNDED_CAPACITY);
+    Node *node = list_pop_front_wait(list);
+    TEST_ASSERT_NOT_NULL(node);
+    size_t offset = (size_t)(node - nodes);
+    size_t producer = offset / BOUNDED_PER_PRODUCER;
+    TEST_ASSERT_TRUE(offset < total);
+    TEST_ASSERT_TRUE(last[producer] == SIZE_MAX ||
+                     offset % BOUNDED_PER_PRODUCER > last[producer]);
+    last[producer] = offset % BOUNDED_PER_PRODUCER;
+  }
+  for (size_t i = 0; i < BOUNDED_PRODUCERS; i++)
+    pthread_join(threads[i], NULL);
+  TEST_ASSERT_TRUE(list_is_empty(list));
+  list_destroy(list, NULL);
+
+  // The plain calls are the try variants; timed ones give up at the deadline
+  list = list_create_bounded(8);
+  for (size_t i = 0; i < 8; i++)
+    TEST_ASSERT_TRUE(list_push_back(list, &nodes[i]));
+  TEST_ASSERT_FALSE(list_push_back(list, &nodes[8]));
+  TEST_ASSERT_FALSE(list_insert(list, 0, &nodes[8]));
+  void *batch[1] = {&nodes[8]};
+  TEST_ASSERT_FALSE(list_append_many(list, batch, 1));
+  double start = now_seconds();
+  TEST_ASSERT_FALSE(list_push_back_timed(list, &nodes[8], 20));
+  TEST_ASSERT_TRUE(now_seconds() - start >= 0.015);
+  TEST_ASSERT_EQUAL(8, list_size(list));
+
+  // A blocked producer is woken as soon as the full queue frees a slot
+  BoundedWork producer = {list, &nodes[8], 1, false, NULL};
+  pthread_t thread;
+  pthread_create(&thread, NULL, bounded_producer, &producer);
+  struct timespec pause = {0, 1000000};
+  for (int i = 0; i < 20; i++)
+    nanosleep(&pause, NULL);
+  TEST_ASSERT_FALSE(__atomic_load_n(&producer.done, __ATOMIC_ACQUIRE));
+  TEST_ASSERT_EQUAL_PTR(&nodes[0], list_pop_front(list));
+  pthread_join(thread, NULL);
+  TEST_ASSERT_EQUAL(8, list_size(list));
+  TEST_ASSERT_EQUAL_PTR(&nodes[8], list_peek_back(list));
+
+  // Two pops in a row wake both producers blocked on a full queue, though
+  // fewer than a batch of slots (a quarter) are free
+  List *small = list_create_bounded(12);
+  for (size_t i = 0; i < 12; i++)
+    TEST_ASSERT_TRUE(list_push_back(small, &nodes[20 + i]));
+  BoundedWork blocked[2] = {{small, &nodes[32], 1, false, NULL},
+                            {small, &nodes[33], 1, false, NULL}};
+  pthread_t blockedThreads[2];
+  for (size_t i = 0; i < 2; i++)
+    pthread_create(&blockedThreads[i], NULL, bounded_timed_producer,
+                   &blocked[i]);
+  for (int i = 0; i < 20; i++)
+    nanosleep(&pause, NULL);
+  TEST_ASSERT_EQUAL_PTR(&nodes[20], list_pop_front(small));
+  TEST_ASSERT_EQUAL_PTR(&nodes[21], list_pop_front(small));
+  for (size_t i = 0; i < 2; i++) {
+    pthread_join(blockedThreads[i], NULL);
+    TEST_ASSERT_TRUE(blocked[i].done);
+  }
+  TEST_ASSERT_EQUAL(12, list_size(small));
+  list_destroy(small, NULL);
+
+  // Closing wakes a consumer waiting on the empty queue; leftovers still pop
+  list_clear(list, NULL);
+  TEST_ASSERT_NULL(list_pop_front_timed(list, 10));
+  BoundedWork consumer = {list, NULL, 0, false, &nodes[0]};
+  pthread_create(&thread, NULL, bounded_consumer, &consumer);
+  for (int i = 0; i < 20; i++)
+    nanosleep(&pause, NULL);
+  TEST_ASSERT_FALSE(__atomic_load_n(&consumer.done, __ATOMIC_ACQUIRE));
+  TEST_ASSERT_TRUE(list_push_back_wait(list, &nodes[0]));
+  pthread_join(thread, NULL);
+  TEST_ASSERT_EQUAL_PTR(&nodes[0], consumer.popped);
+  TEST_ASSERT_TRUE(list_push_back(list, &nodes[1]));
+  consumer = (BoundedWork){list, NULL, 0, false, NULL};
+  list_bounded_close(list);
+  TEST_ASSERT_FALSE(list_push_back_wait(list, &nodes[2]));
+  TEST_ASSERT_EQUAL_PTR(&nodes[1], list_pop_front_wait(list));
+  pthread_create(&thread, NULL, bounded_consumer, &consumer);
+  pthread_join(thread, NULL);
+  TEST_ASSERT_NULL(consumer.popped);
+
+  list_destroy(list, NULL);
+  free(nodes);
+}
+
+#define MPSC_PRODUCERS 3
+#define MPSC_PER_PRODUCER 6000
+
+static void *mpsc_producer(void *arg) {
+  ConcurrentWork *work = arg;
+  for (size_t i = 0; i < MPSC_PER_PRODUCER;) {
+    // Alternate single appends with batches linked in one exchange
+    if (i % 16 == 0 && i + 8 <= MPSC_PER_PRODUCER) {
+      void *batch[8];
+      for (size_t j = 0; j < 8; j++)
+        batch[j] = &work->nodes[i + j];
+      list_append_many(work->list, batch, 8);
+      i += 8;
+    } else {
+      list_append(work->list, &work->nodes[i]);
+      i += 1;
+    }
+  }
+  return NULL;
+}
+
+void test_mpsc_queue_threads(void) {
+  List *list = list_create(LIST_MPSC);
+  TEST_ASSERT_NOT_NULL(list);
+  Node *nodes = calloc(MPSC_PRODUCERS * MPSC_PER_PRODUCER, sizeof(Node));
+  for (size_t i = 0; i < MPSC_PRODUCERS * MPSC_PER_PRODUCER; i++)
+    nodes[i].type = NODE;
+
+  // Single-threaded: append, peek, iterate and pop in FIFO order
+  TEST_ASSERT_NULL(list_remove(list, 0));
+  for (size_t i = 0; i < 5; i++)
+    TEST_ASSERT_TRUE(list_append(list, &nodes[i]));
+  TEST_ASSERT_FALSE(list_insert(list, 0, &nodes[5]));
+  TEST_ASSERT_NULL(list_remove(list, 1));
+  TEST_ASSERT_NULL(list_split_at(list, 2));
+  TEST_ASSERT_EQUAL(5, list_size(list));
+  TEST_ASSERT_EQUAL_PTR(&nodes[3], list_get(list, 3));
+  ListIter iter = iter_begin(list);
+  for (size_t i = 0; i < 5; i++) {
+    TEST_ASSERT_EQUAL_PTR(&nodes[i], iter_get(&iter));
+    iter_next(&iter);
+  }
+  TEST_ASSERT_NULL(iter_get(&iter));
+  iter = iter_begin(list);
+  TEST_ASSERT_EQUAL_PTR(&nodes[0], iter_remove(&iter));
+  TEST_ASSERT_EQUAL_PTR(&nodes[1], iter_get(&iter));
+  TEST_ASSERT_EQUAL_PTR(&nodes[1], list_remove(list, 0));
+  list_clear(list, NULL);
+  TEST_ASSERT_TRUE(list_is_empty(list));
+
+  // Producers race each other while the consumer drains
+  pthread_t threads[MPSC_PRODUCERS];
+  ConcurrentWork work[MPSC_PRODUCERS];
+  for (size_t p = 0; p < MPSC_PRODUCERS; p++) {
+    work[p].list = list;
+    work[p].nodes = &nodes[p * MPSC_PER_PRODUCER];
+    work[p].reads = 0;
+    pthread_create(&threads[p], NULL, mpsc_producer, &work[p]);
+  }
+
+  size_t total = MPSC_PRODUCERS * MPSC_PER_PRODUCER, popped = 0;
+  Node *last[MPSC_PRODUCERS] = {NULL};
+  bool ordered = true;
+  while (popped < total) {
+    Node *node = list_remove(list, 0);
+    if (!node)
+      continue;
+    // Each producer's nodes come out in the order it appended them
+    size_t p = (size_t)(node - nodes) / MPSC_PER_PRODUCER;
+    if (last[p] && node <= last[p])
+      ordered = false;
+    last[p] = node;
+    popped += 1;
+  }
+  for (size_t p = 0; p < MPSC_PRODUCERS; p++)
+    pthread_join(threads[p], NULL);
+
+  TEST_ASSERT_TRUE(ordered);
+  TEST_ASSERT_TRUE(list_is_empty(list));
+  TEST_ASSERT_NULL(list_remove(list, 0));
+
+  // Cleanup (nodes are owned by the test)
+  list_destroy(list, NULL);
+  free(nodes);
+}
+
+#define DEQUE_THIEVES 3
+#define DEQUE_ITEMS 50000
+
+typedef struct DequeWork {
+  List *list;
+  int *claims; // how many times each item was taken
+  int *items;
+  bool *done;
+} DequeWork;
+
+static void *deque_thief(void *arg) {
+  DequeWork *work = arg;
+  for (;;) {
+    int *item = list_pop_front(work->list);
+    if (item) {
+      __atomic_fetch_add(&work->claims[item - work->items], 1,
+                         __ATOMIC_RELAXED);
+    } else if (__atomic_load_n(work->done, __ATOMIC_ACQUIRE)) {
+      break;
+    }
+  }
+  return NULL;
+}
+
+void test_lockfree_deque_stress(void) {
+  List *list = list_create(LIST_DEQUE_LOCKFREE);
+  TEST_ASSERT_NOT_NULL(list);
+  int *items = malloc(DEQUE_ITEMS * sizeof(int));
+  int *claims = calloc(DEQUE_ITEMS, sizeof(int));
+
+  // Single-threaded: owner end is LIFO, the front is FIFO
+  for (int i = 0; i < 100; i++) {
+    items[i] = i;
+    TEST_ASSERT_TRUE(list_push_back(list, &items[i]));
+  }
+  TEST_ASSERT_FALSE(list_push_front(list, &items[0]));
+  TEST_ASSERT_FALSE(list_insert(list, 3, &items[0]));
+  TEST_ASSERT_NULL(list_split_at(list, 3));
+  TEST_ASSERT_EQUAL(100, list_size(list));
+  TEST_ASSERT_EQUAL_PTR(&items[42], list_get(list, 42));
+  TEST_ASSERT_EQUAL_PTR(&items[99], list_pop_back(list));
+  TEST_ASSERT_EQUAL_PTR(&items[0], list_pop_front(list));
+  TEST_ASSERT_EQUAL_PTR(&items[98], list_remove(list, list_size(list) - 1));
+  TEST_ASSERT_NULL(list_remove(list, 5));
+  list_clear(list, NULL);
+  TEST_ASSERT_TRUE(list_is_empty(list));
+  TEST_ASSERT_NULL(list_pop_back(list));
+  TEST_ASSERT_NULL(list_pop_front(list));
+
+  // The owner pushes (growing the buffer) and pops while thieves steal
+  bool done = false;
+  pthread_t threads[DEQUE_THIEVES];
+  DequeWork work = {list, claims, items, &done};
+  for (size_t t = 0; t < DEQUE_THIEVES; t++)
+    pthread_create(&threads[t], NULL, deque_thief, &work);
+
+  for (int i = 0; i < DEQUE_ITEMS; i++) {
+    items[i] = i;
+    TEST_ASSERT_TRUE(list_push_back(list, &items[i]));
+    if (i % 5 == 4) {
+      int *item = list_pop_back(list);
+      if (item)
+        __atomic_fetch_add(&claims[item - items], 1, __ATOMIC_RELAXED);
+    }
+  }
+  __atomic_store_n(&done, true, __ATOMIC_RELEASE);
+  for (size_t t = 0; t < DEQUE_THIEVES; t++)
+    pthread_join(threads[t], NULL);
+
+  // Whatever the thieves left behind, the owner drains
+  int *item;
+  while ((item = list_pop_back(list)))
+    claims[item - items] += 1;
+
+  // Every item was taken exactly once
+  for (int i = 0; i < DEQUE_ITEMS; i++)
+    TEST_ASSERT_EQUAL(1, claims[i]);
+
+  // Cleanup (items are owned by the test)
+  list_destroy(list, NULL);
+  free(claims);
+  free(items);
+}
+
+#define PARALLEL_ITEMS 5000
+
+typedef struct ParallelVisit {
+  Node *nodes;
+  size_t *visits;
+  List *inner; // visited again from inside the first call, if set
+  size_t inner_visits;
+} ParallelVisit;
+
+static void parallel_count_visit(void *data, size_t index, void *ctx) {
+  ParallelVisit *visit = ctx;
+  // Elements sit at their own index, so a wrong index shows up as a miss
+  size_t offset = (size_t)((Node *)data - visit->nodes);
+  if (offset == index)
+    __atomic_fetch_add(&visit->visits[index], 1, __ATOMIC_RELAXED);
+}
+
+static void parallel_nested_visit(void *data, size_t index, void *ctx) {
+  ParallelVisit *visit = ctx;
+  (void)data;
+  if (index == 0) {
+    ParallelVisit inner = {visit->nodes, visit->visits, NULL, 0};
+    list_parallel_for_each(visit->inner, parallel_count_visit, &inner, 4);
+  }
+}
+
+void test_parallel_for_each_all_types(void) {
+  ListType types[] = {LIST_LINKED_SENTINEL, LIST_ARRAY,   LIST_GAP_BUFFER,
+                      LIST_UNROLLED,        LIST_SKIP,    LIST_TREE,
+                      LIST_CONCURRENT,      LIST_MPSC,    LIST_DEQUE_LOCKFREE,
+                      LIST_RCU,             LIST_SHARDED, LIST_BOUNDED};
+  Node *nodes = calloc(PARALLEL_ITEMS, sizeof(Node));
+  size_t *visits = calloc(PARALLEL_ITEMS, sizeof(size_t));
+  size_t threads[] = {1, 3, 0};
+
+  for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+    List *list = (types[t] == LIST_BOUNDED)
+                     ? list_create_bounded(PARALLEL_ITEMS)
+                     : list_create(types[t]);
+    ParallelVisit visit = {nodes, visits, NULL, 0};
+    // An empty list calls nothing
+    list_parallel_for_each(list, parallel_count_visit, &visit, 4);
+    for (size_t i = 0; i < PARALLEL_ITEMS; i++) {
+      nodes[i].type = NODE;
+      TEST_ASSERT_TRUE(list_append(list, &nodes[i]));
+    }
+
+    for (size_t n = 0; n < sizeof(threads) / sizeof(threads[0]); n++) {
+      memset(visits, 0, PARALLEL_ITEMS * sizeof(size_t));
+      list_parallel_for_each(list, parallel_count_visit, &visit, threads[n]);
+      for (size_t i = 0; i < PARALLEL_ITEMS; i++)
+        TEST_ASSERT_EQUAL(1, visits[i]);
+    }
+    TEST_ASSERT_EQUAL(PARALLEL_ITEMS, list_size(list));
+    list_destroy(list, NULL);
+  }
+
+  // A call from inside another runs inline instead of waiting on the pool
+  List *outer = list_create(LIST_ARRAY);
+  List *inner = list_create(LIST_ARRAY);
+  for (size_t i = 0; i < PARALLEL_ITEMS; i++) {
+    list_append(outer, &nodes[i]);
+    list_append(inner, &nodes[i]);
+  }
+  memset(visits, 0, PARALLEL_ITEMS * sizeof(size_t));
+  ParallelVisit nested = {nodes, visits, inner, 0};
+  list_parallel_for_each(outer, parallel_nested_visit, &nested, 4);
+  for (size_t i = 0; i < PARALLEL_ITEMS; i++)
+    TEST_ASSERT_EQUAL(1, visits[i]);
+
+  list_destroy(inner, NULL);
+  list_destroy(outer, NULL);
+  free(visits);
+  free(nodes);
+}
+
+typedef struct ParallelItem {
+  Node node; // first, so the item is its node
+  uint64_t value;
+} ParallelItem;
+
+static void parallel_transform(void *data, size_t index, void *ctx) {
+  ParallelItem *item = data;
+  (void)ctx;
+  // A pure per-element transform with some arithmetic to it
+  uint64_t value = index + 1;
+  for (int i = 0; i < 64; i++)
+    value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+  item->value = value;
+}
+
+void test_parallel_for_each_throughput(void) {
+  const size_t count = 1000000;
+  ParallelItem *items = malloc(count * sizeof(ParallelItem));
+  List *list = list_create(LIST_LINKED_SENTINEL);
+  for (size_t i = 0; i < count; i++) {
+    items[i].node.type = NODE;
+    list_append(list, &items[i]);
+  }
+
+  double start = now_seconds();
+  list_parallel_for_each(list, parallel_transform, NULL, 1);
+  double single = now_seconds() - start;
+  uint64_t first = items[0].value, last = items[count - 1].value;
+
+  for (size_t i = 0; i < count; i++)
+    items[i].value = 0;
+  start = now_seconds();
+  list_parallel_for_each(list, parallel_transform, NULL, 4);
+  double parallel = now_seconds() - start;
+  TEST_ASSERT_EQUAL_UINT64(first, items[0].value);
+  TEST_ASSERT_EQUAL_UINT64(last, items[count - 1].value);
+
+  printf("\nparallel_for_each x%zu: 1 thread %.3f ms, 4 threads %.3f ms "
+         "(%.2fx)\n",
+         count, single * 1e3, parallel * 1e3, single / parallel);
+
+  list_destroy(list, NULL);
+  free(items);
+}
+
+#define SORT_ITEMS 6000
+
+typedef struct SortItem {
+  Node node; // first, so the item is its node
+  int key;
+  size_t seq; // append order, to check stability
+} SortItem;
+
+// Shared types that can be sorted (locked whole), after the sequential ones
+static const ListType sortable_shared_types[] = {LIST_CONCURRENT, LIST_SHARDED,
+                                                 LIST_BOUNDED};
+#define SORTABLE_TYPE_COUNT                                                    \
+  (sequential_type_count +                                                     \
+   sizeof(sortable_shared_types) / sizeof(sortable_shared_types[0]))
+
+static ListType sortable_type(size_t t) {
+  return (t < sequential_type_count)
+             ? sequential_types[t]
+             : sortable_shared_types[t - sequential_type_count];
+}
+
+static int sort_item_compare(const void *a, const void *b) {
+  const SortItem *x = a, *y = b;
+  return (x->key > y->key) - (x->key < y->key);
+}
+
+// Create a list of a sortable type, sized for SORT_ITEMS
+static List *sort_create(ListType type) {
+  return (type == LIST_BOUNDED) ? list_create_bounded(SORT_ITEMS)
+                                : list_create(type);
+}
+
+// Fill a list with many ties, in an order unrelated to the keys
+static void sort_fill(List *list, SortItem *items) {
+  for (size_t i = 0; i < SORT_ITEMS; i++) {
+    items[i].node.type = NODE;
+    items[i].key = (int)((i * 7919) % 97);
+    items[i].seq = i;
+    TEST_ASSERT_TRUE(list_append(list, &items[i]));
+  }
+  // Leave the gap (and the finger) mid-list
+  TEST_ASSERT_EQUAL_PTR(&items[SORT_ITEMS / 2],
+                        list_remove(list, SORT_ITEMS / 2));
+  TEST_ASSERT_TRUE(list_insert(list, SORT_ITEMS / 2, &items[SORT_ITEMS / 2]));
+}
+
+// Check a sorted list, recording its order in `sorted`
+static void assert_sorted_stable(List *list, SortItem **sorted) {
+  TEST_ASSERT_EQUAL(SORT_ITEMS, list_size(list));
+
+  // Keys ascend, and equal keys keep their append order
+  size_t seen = 0;
+  ListIter iter = iter_begin(list);
+  for (void *data = iter_get(&iter); data; data = iter_get(&iter)) {
+    SortItem *item = data;
+    if (seen > 0)
+      TEST_ASSERT_TRUE(sorted[seen - 1]->key < item->key ||
+                       (sorted[seen - 1]->key == item->key &&
+                        sorted[seen - 1]->seq < item->seq));
+    sorted[seen++] = item;
+    iter_next(&iter);
+  }
+  TEST_ASSERT_EQUAL(SORT_ITEMS, seen);
+
+  // Links both ways and positional lookups agree with the new order
+  size_t back = SORT_ITEMS;
+  for (iter = iter_end(list); iter_prev(&iter);)
+    TEST_ASSERT_EQUAL_PTR(sorted[--back], iter_get(&iter));
+  TEST_ASSERT_EQUAL(0, back);
+  for (size_t i = 0; i < SORT_ITEMS; i += 371)
+    TEST_ASSERT_EQUAL_PTR(sorted[i], list_get(list, i));
+  TEST_ASSERT_EQUAL_PTR(sorted[SORT_ITEMS - 1], list_peek_back(list));
+}
+
+void test_list_sort_all_types(void) {
+  SortItem *items = malloc(SORT_ITEMS * sizeof(SortItem));
+  SortItem **sorted = malloc(SORT_ITEMS * sizeof(SortItem *));
+  // 0 for list_sort; an odd count of runs leaves one out of a merge round
+  size_t threads[] = {0, 3, 4};
+
+  for (size_t t = 0; t < SORTABLE_TYPE_COUNT; t++) {
+    ListType type = sortable_type(t);
+    for (size_t n = 0; n < sizeof(threads) / sizeof(threads[0]); n++) {
+      List *list = sort_create(type);
+      TEST_ASSERT_TRUE(list_sort(list, sort_item_compare));
+      sort_fill(list, items);
+      TEST_ASSERT_TRUE(
+          (threads[n] > 0)
+              ? list_sort_parallel(list, sort_item_compare, threads[n])
+              : list_sort(list, sort_item_compare));
+      assert_sorted_stable(list, sorted);
+      list_destroy(list, NULL);
+    }
+  }
+
+  // Lock-free and RCU lists can't be sorted
+  ListType unsorted[] = {LIST_MPSC, LIST_DEQUE_LOCKFREE, LIST_RCU};
+  for (size_t t = 0; t < sizeof(unsorted) / sizeof(unsorted[0]); t++) {
+    List *list = list_create(unsorted[t]);
+    TEST_ASSERT_FALSE(list_sort(list, sort_item_compare));
+    TEST_ASSERT_FALSE(list_sort_parallel(list, sort_item_compare, 4));
+    list_destroy(list, NULL);
+  }
+
+  free(sorted);
+  free(items);
+}
+
+// Spread the key over every byte so no radix pass is skipped
+static uint64_t sort_item_key(const void *data) {
+  return (uint64_t)((const SortItem *)data)->key * UINT64_C(0x0101010101010101);
+}
+
+void test_list_sort_by_key_all_types(void) {
+  SortItem *items = malloc(SORT_ITEMS * sizeof(SortItem));
+  SortItem **sorted = malloc(SORT_ITEMS * sizeof(SortItem *));
+
+  for (size_t t = 0; t < SORTABLE_TYPE_COUNT; t++) {
+    ListType type = sortable_type(t);
+    List *list = sort_create(type);
+    TEST_ASSERT_TRUE(list_sort_by_key(list, sort_item_key));
+    sort_fill(list, items);
+    TEST_ASSERT_TRUE(list_sort_by_key(list, sort_item_key));
+    assert_sorted_stable(list, sorted);
+
+    // Already sorted keys take the same path and stay put
+    TEST_ASSERT_TRUE(list_sort_by_key(list, sort_item_key));
+    for (size_t i = 0; i < SORT_ITEMS; i += 371)
+      TEST_ASSERT_EQUAL_PTR(sorted[i], list_get(list, i));
+    list_destroy(list, NULL);
+  }
+
+  ListType unsorted[] = {LIST_MPSC, LIST_DEQUE_LOCKFREE, LIST_RCU};
+  for (size_t t = 0; t < sizeof(unsorted) / sizeof(unsorted[0]); t++) {
+    List *list = list_create(unsorted[t]);
+    TEST_ASSERT_FALSE(list_sort_by_key(list, sort_item_key));
+    list_destroy(list, NULL);
+  }
+
+  free(sorted);
+  free(items);
+}
+
+typedef struct KeyedItem {
+  Node node;
+  uint64_t key;
+} KeyedItem;
+
+static int keyed_item_compare(const void *a, const void *b) {
+  const KeyedItem *x = a, *y = b;
+  return (x->key > y->key) - (x->key < y->key);
+}
+
+static uint64_t keyed_item_key(const void *data) {
+  return ((const KeyedItem *)data)->key;
+}
+
+void test_sort_by_key_throughput(void) {
+  const size_t count = 1000000;
+  KeyedItem *items = malloc(count * sizeof(KeyedItem));
+  List *list = list_create(LIST_LINKED_SENTINEL);
+  uint64_t state = 88172645463325252ULL;
+  for (size_t i = 0; i < count; i++) {
+    // xorshift64, for keys spread over the whole range
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    items[i].node.type = NODE;
+    items[i].key = state;
+    list_append(list, &items[i]);
+  }
+
+  double start = now_seconds();
+  TEST_ASSERT_TRUE(list_sort(list, keyed_item_compare));
+  double merge = now_seconds() - start;
+
+  // Back to append order, then sort again by key
+  for (size_t i = 0; i < count; i++)
+    list_remove(list, 0);
+  for (size_t i = 0; i < count; i++)
+    list_append(list, &items[i]);
+  start = now_seconds();
+  TEST_ASSERT_TRUE(list_sort_by_key(list, keyed_item_key));
+  double radix = now_seconds() - start;
+
+  uint64_t prev = 0;
+  ListIter iter = iter_begin(list);
+  for (void *data = iter_get(&iter); data; data = iter_get(&iter)) {
+    TEST_ASSERT_TRUE(prev <= ((KeyedItem *)data)->key);
+    prev = ((KeyedItem *)data)->key;
+    iter_next(&iter);
+  }
+
+  printf("\nsort x%zu: list_sort %.3f ms, list_sort_by_key %.3f ms "
+         "(%.2fx)\n",
+         count, merge * 1e3, radix * 1e3, merge / radix);
+
+  list_destroy(list, NULL);
+  free(items);
+}
+
 int main(void) {
   UNITY_BEGIN();
   RUN_TEST(test_list_create);
@@ -318,5 +2359,41 @@ int main(void) {
   RUN_TEST(test_remove);
   RUN_TEST(test_remove_out_of_bounds);
   RUN_TEST(test_list_is_empty);
+  RUN_TEST(test_array_list_append_get);
+  RUN_TEST(test_array_list_insert_remove);
+  RUN_TEST(test_array_list_destroy_frees_elements);
+  RUN_TEST(test_gap_buffer_cursor_edits);
+  RUN_TEST(test_gap_buffer_destroy_frees_elements);
+  RUN_TEST(test_unrolled_list_matches_array);
+  RUN_TEST(test_skip_list_matches_array);
+  RUN_TEST(test_tree_list_matches_array);
+  RUN_TEST(test_iterator_all_types);
+  RUN_TEST(test_sequential_get_uses_finger);
+  RUN_TEST(test_insert_many_all_types);
+  RUN_TEST(test_append_many_throughput);
+  RUN_TEST(test_splice_concat_all_types);
+  RUN_TEST(test_split_at_all_types);
+  RUN_TEST(test_node_pool_recycles_sentinel_nodes);
+  RUN_TEST(test_node_pool_splice_needs_shared_pool);
+  RUN_TEST(test_node_pool_internal_nodes);
+  RUN_TEST(test_allocator_hooks_all_types);
+  RUN_TEST(test_batch_allocation_failure);
+  RUN_TEST(test_unrolled_splice_allocators);
+  RUN_TEST(test_create_destroy_throughput);
+  RUN_TEST(test_list_init_caller_storage);
+  RUN_TEST(test_list_clear_all_types);
+  RUN_TEST(test_push_pop_peek_all_types);
+  RUN_TEST(test_concurrent_list_threads);
+  RUN_TEST(test_mpsc_queue_threads);
+  RUN_TEST(test_lockfree_deque_stress);
+  RUN_TEST(test_rcu_list_readers_threads);
+  RUN_TEST(test_rcu_list_delayed_reader);
+  RUN_TEST(test_sharded_list_threads);
+  RUN_TEST(test_bounded_queue_threads);
+  RUN_TEST(test_parallel_for_each_all_types);
+  RUN_TEST(test_parallel_for_each_throughput);
+  RUN_TEST(test_list_sort_all_types);
+  RUN_TEST(test_list_sort_by_key_all_types);
+  RUN_TEST(test_sort_by_key_throughput);
   return UNITY_END();
 }